@@ -0,0 +1,13 @@
+//include/benchmark/AllocationCounter.hpp
+#pragma once
+
+#include <cstdint>
+
+// Heap allocations made through the global operator new since the process
+// started, across all threads. The replacement operators that count them
+// are linked into the benchmark executable only.
+namespace AllocationCounter {
+
+std::uint64_t count();
+
+}
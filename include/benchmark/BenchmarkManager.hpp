@@ -10,9 +10,13 @@
 //Structure to store the results of each test
 struct BenchmarkResult {
     std::string solverName;
+    int numThreads;
     std::string puzzleName;
     double timeMs;
     bool success;
+    std::string valueOrder = "ascending";
+    std::uint64_t nodeCount = 0;   // 0 when the solver does not count nodes
+    std::uint64_t allocations = 0; // most heap allocations of one warm solve (runAllocationBenchmarks)
 };
 
 class BenchmarkManager {
@@ -20,18 +24,42 @@ public:
     // Constructor: pass in all test file paths
     explicit BenchmarkManager(const std::vector<std::string>& puzzlePaths);
 
-    // Add a solver and its name
-    void addSolver(const std::string& name, std::unique_ptr<SolverBase> solver);
+    // Add a solver and its name; numThreads is recorded with its results
+    void addSolver(const std::string& name, std::unique_ptr<SolverBase> solver, int numThreads = 1);
+
+    // Value order for every solver, also those added later. Solvers that
+    // reject it keep theirs and are reported as ascending.
+    void setValueOrder(ValueOrder order, unsigned seed = 1);
 
     // Execute all test and problem solver benchmarks
     void runBenchmarks();
 
+    // Solve copies of every puzzle as one batch per solver and report the
+    // throughput in puzzles per second
+    void runBatchBenchmarks(int copies, const BatchOptions& options);
+
+    // Solves every puzzle once to warm each solver up, then rounds more
+    // times, and reports the most heap allocations a single one of those
+    // solves made (AllocationCounter). Solvers that reuse their storage
+    // report 0.
+    void runAllocationBenchmarks(int rounds);
+
     // Output results to CSV file
     void exportResultsCSV(const std::string& path) const;
 
 private:
     std::vector<std::string> puzzlePaths;
-    std::vector<std::pair<std::string, std::unique_ptr<SolverBase>>> solvers;
+    struct SolverEntry {
+        std::string name;
+        std::unique_ptr<SolverBase> solver;
+        int numThreads;
+        ValueOrder valueOrder;
+    };
+    std::vector<SolverEntry> solvers;
+    ValueOrder valueOrder = ValueOrder::Ascending;
+    unsigned valueOrderSeed = 1;
+
+    void applyValueOrder(SolverEntry& entry);
     std::vector<BenchmarkResult> results;
 
     // Single test Benchmark execution
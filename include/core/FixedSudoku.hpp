@@ -0,0 +1,171 @@
+//include/core/FixedSudoku.hpp
+#pragma once
+
+#include "Sudoku.hpp"
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+// Compile-time sized boards. Fixed::Sudoku<N> mirrors the runtime Sudoku but
+// every bound, box index and mask width is a constant, so the solver kernels
+// built on it get unrolled loops instead of size-driven ones.
+namespace Fixed {
+
+constexpr int isqrt(int n) {
+    int r = 0;
+    while ((r + 1) * (r + 1) <= n) ++r;
+    return r;
+}
+
+template <int N>
+struct Geometry {
+    static_assert(isqrt(N) * isqrt(N) == N, "board size must be a perfect square");
+
+    static constexpr int Size = N;
+    static constexpr int BoxSize = isqrt(N);
+    static constexpr int Cells = N * N;
+    static constexpr int NumPeers = 2 * (N - 1) + (BoxSize - 1) * (BoxSize - 1);
+
+    using Mask = std::conditional_t<(N <= 16), std::uint16_t,
+                 std::conditional_t<(N <= 32), std::uint32_t, std::uint64_t>>;
+    static constexpr Mask FullMask = static_cast<Mask>(N == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << N) - 1);
+
+    using CellTable = std::array<std::uint8_t, Cells>;
+    using PeerTable = std::array<std::array<std::uint16_t, NumPeers>, Cells>;
+
+    static constexpr CellTable buildRowOf() {
+        CellTable t{};
+        for (int i = 0; i < Cells; ++i) t[i] = static_cast<std::uint8_t>(i / N);
+        return t;
+    }
+    static constexpr CellTable buildColOf() {
+        CellTable t{};
+        for (int i = 0; i < Cells; ++i) t[i] = static_cast<std::uint8_t>(i % N);
+        return t;
+    }
+    static constexpr CellTable buildBoxOf() {
+        CellTable t{};
+        for (int i = 0; i < Cells; ++i)
+            t[i] = static_cast<std::uint8_t>((i / N / BoxSize) * BoxSize + (i % N) / BoxSize);
+        return t;
+    }
+    // Row by row, in ascending cell order, rather than testing every pair
+    // of cells
+    static constexpr PeerTable buildPeers() {
+        PeerTable t{};
+        for (int i = 0; i < Cells; ++i) {
+            int k = 0;
+            const int r = i / N, c = i % N;
+            for (int rj = 0; rj < N; ++rj) {
+                if (rj == r) {
+                    for (int cj = 0; cj < N; ++cj)
+                        if (cj != c) t[i][k++] = static_cast<std::uint16_t>(rj * N + cj);
+                } else if (rj / BoxSize == r / BoxSize) {
+                    for (int cj = 0; cj < N; ++cj)
+                        if (cj == c || cj / BoxSize == c / BoxSize)
+                            t[i][k++] = static_cast<std::uint16_t>(rj * N + cj);
+                } else {
+                    t[i][k++] = static_cast<std::uint16_t>(rj * N + c);
+                }
+            }
+        }
+        return t;
+    }
+
+    static constexpr CellTable rowOf = buildRowOf();
+    static constexpr CellTable colOf = buildColOf();
+    static constexpr CellTable boxOf = buildBoxOf();
+    static constexpr PeerTable peers = buildPeers();
+};
+
+template <int N>
+class Sudoku {
+public:
+    using Geo = Geometry<N>;
+    using Mask = typename Geo::Mask;
+
+    // Copy the givens of a runtime board. Returns false on duplicated givens.
+    bool load(const ::Sudoku& board) {
+        cells.fill(0);
+        rowMask.fill(0);
+        colMask.fill(0);
+        boxMask.fill(0);
+        bool consistent = true;
+        for (int i = 0; i < Geo::Cells; ++i) {
+            const int val = board.getValue(i / N, i % N);
+            if (val == 0) continue;
+            if (!(candidates(i) & bitOf(val))) consistent = false;
+            set(i, val);
+        }
+        return consistent;
+    }
+
+    void store(::Sudoku& board) const {
+        for (int i = 0; i < Geo::Cells; ++i)
+            board.setValue(i / N, i % N, cells[i]);
+    }
+
+    static constexpr Mask bitOf(int val) { return static_cast<Mask>(Mask(1) << (val - 1)); }
+
+    int value(int cell) const { return cells[cell]; }
+
+    Mask candidates(int cell) const {
+        return static_cast<Mask>(Geo::FullMask &
+            ~(rowMask[Geo::rowOf[cell]] | colMask[Geo::colOf[cell]] | boxMask[Geo::boxOf[cell]]));
+    }
+
+    void set(int cell, int val) {
+        const Mask bit = bitOf(val);
+        cells[cell] = static_cast<std::uint8_t>(val);
+        rowMask[Geo::rowOf[cell]] |= bit;
+        colMask[Geo::colOf[cell]] |= bit;
+        boxMask[Geo::boxOf[cell]] |= bit;
+    }
+
+    void clear(int cell) {
+        const Mask bit = static_cast<Mask>(~bitOf(cells[cell]));
+        cells[cell] = 0;
+        rowMask[Geo::rowOf[cell]] &= bit;
+        colMask[Geo::colOf[cell]] &= bit;
+        boxMask[Geo::boxOf[cell]] &= bit;
+    }
+
+    // True when no empty peer of cell has run out of candidates
+    bool peersAlive(int cell) const {
+        for (int p : Geo::peers[cell])
+            if (cells[p] == 0 && candidates(p) == 0) return false;
+        return true;
+    }
+
+private:
+    std::array<std::uint8_t, Geo::Cells> cells{};
+    std::array<Mask, N> rowMask{};
+    std::array<Mask, N> colMask{};
+    std::array<Mask, N> boxMask{};
+};
+
+// Sizes with a compiled-in specialization. Larger boards go to the runtime
+// engines: the peer tables of 36x36 and up are too costly to build at
+// compile time, and row-major backtracking does not pay off there anyway.
+constexpr std::array<int, 3> SupportedSizes = {9, 16, 25};
+
+inline bool isSupported(int size) {
+    for (int s : SupportedSizes)
+        if (s == size) return true;
+    return false;
+}
+
+// Runtime -> compile-time bridge: calls f(std::integral_constant<int, N>{})
+// for the matching instantiation. Returns false for sizes without one.
+template <typename F>
+bool dispatch(int size, F&& f) {
+    switch (size) {
+        case 9:  f(std::integral_constant<int, 9>{});  return true;
+        case 16: f(std::integral_constant<int, 16>{}); return true;
+        case 25: f(std::integral_constant<int, 25>{}); return true;
+        default: return false;
+    }
+}
+
+}
@@ -0,0 +1,70 @@
+//include/core/ScratchArena.hpp
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// Bump allocator for short-lived arrays of trivial values. reset() drops
+// everything handed out but keeps the blocks, so once the arena has grown
+// to a workload's high-water mark it no longer calls the heap. Not
+// thread-safe: give each worker its own.
+class ScratchArena {
+public:
+    explicit ScratchArena(std::size_t blockBytes = 16 * 1024) : blockBytes(blockBytes) {}
+
+    template <typename T>
+    T* allocate(std::size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value && std::is_trivially_destructible<T>::value,
+                      "ScratchArena never runs destructors");
+        static_assert(alignof(T) <= alignof(std::max_align_t), "blocks are max_align_t aligned");
+        return static_cast<T*>(take(count * sizeof(T), alignof(T)));
+    }
+
+    template <typename T>
+    T* copy(const T* values, std::size_t count) {
+        T* p = allocate<T>(count);
+        if (count) std::memcpy(p, values, count * sizeof(T));
+        return p;
+    }
+
+    // Everything allocated so far becomes invalid
+    void reset() {
+        current = 0;
+        used = 0;
+    }
+
+    std::size_t getCapacityBytes() const {
+        std::size_t total = 0;
+        for (const Block& b : blocks) total += b.size;
+        return total;
+    }
+
+private:
+    struct Block {
+        std::unique_ptr<unsigned char[]> data;
+        std::size_t size;
+    };
+
+    std::size_t blockBytes;
+    std::vector<Block> blocks;
+    std::size_t current = 0;   // block being filled
+    std::size_t used = 0;      // bytes taken from it
+
+    void* take(std::size_t bytes, std::size_t alignment) {
+        for (; current < blocks.size(); ++current, used = 0) {
+            const std::size_t offset = (used + alignment - 1) & ~(alignment - 1);
+            if (offset + bytes <= blocks[current].size) {
+                used = offset + bytes;
+                return blocks[current].data.get() + offset;
+            }
+        }
+        // Past the high-water mark: the new block stays for later rounds
+        const std::size_t size = bytes > blockBytes ? bytes : blockBytes;
+        blocks.push_back({std::unique_ptr<unsigned char[]>(new unsigned char[size]), size});
+        used = bytes;
+        return blocks[current].data.get();
+    }
+};
@@ -3,9 +3,22 @@
 
 #include <vector>
 #include <string>
+#include <cstdint>
 
 class Sudoku {
 public:
+    // One bit per value: bit (val - 1) is set when val is present / allowed
+    using Mask = std::uint64_t;
+
+    // Largest board a Mask can describe
+    static constexpr int MaxSize = 64;
+
+    // Text symbol of a value: 0 (empty), 1-9, then A-Z, a-z, '@', '#' and
+    // '$' for 10-64. symbolValue maps back and also accepts '.' as empty;
+    // it returns -1 for anything else.
+    static char valueSymbol(int val);
+    static int symbolValue(char symbol);
+
     explicit Sudoku(int size = 9);
 
     bool loadFromFile(const std::string& filename);
@@ -14,17 +27,43 @@ public:
     void setValue(int row, int col, int val);
     int getValue(int row, int col) const;
 
+    // Values that can legally be placed at (row, col), as a bitmask
+    Mask getCandidates(int row, int col) const;
+    Mask getFullMask() const;
+
     int getSize() const;
-    const std::vector<std::vector<int>>& getBoard() const;
+    int getBoxSize() const;
+    int getBoxIndex(int row, int col) const;
+    // Row-major view of the cells, one value per cell, without copying
+    const std::vector<std::uint8_t>& getCells() const;
+    // Copy of the cells as rows; loops should use getValue / getCells
+    std::vector<std::vector<int>> getBoard() const;
     std::vector<std::pair<int, int>> getEmptyCells() const;
     void print() const;
 
 private:
     int size;
     int boxSize; // e.g., 3 for 9x9
-    std::vector<std::vector<int>> board;
+    int filled;  // number of non-empty cells
+
+    std::vector<std::uint8_t> cells; // row-major, size * size
+
+    // Occupancy bitmasks, kept in sync by setValue
+    std::vector<Mask> rowMask;
+    std::vector<Mask> colMask;
+    std::vector<Mask> boxMask;
+
+    // Occurrences of each value per unit, so that clearing a duplicated
+    // value (invalid input) does not drop the bit of the remaining copy
+    std::vector<std::uint8_t> rowCount;
+    std::vector<std::uint8_t> colCount;
+    std::vector<std::uint8_t> boxCount;
+
+    void reset(int n);
+    void place(int row, int col, int val);
+    void remove(int row, int col, int val);
 
     bool isRowValid(int row, int val) const;
     bool isColValid(int col, int val) const;
-    bool isBoxValid(int startRow, int startCol, int val) const;
+    bool isBoxValid(int box, int val) const;
 };
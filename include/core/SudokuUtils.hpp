@@ -4,10 +4,10 @@
 #include "Sudoku.hpp"
 #include <iostream>
 #include <cmath>
+#include <vector>
 namespace SudokuUtils {
 
 inline void printSudoku(const Sudoku& sudoku) {
-    const auto& board = sudoku.getBoard();
     int size = sudoku.getSize();
     int boxSize = static_cast<int>(std::sqrt(size));
 
@@ -19,14 +19,76 @@ inline void printSudoku(const Sudoku& sudoku) {
             if (c % boxSize == 0 && c != 0)
                 std::cout << "| ";
 
-            int val = board[r][c];
+            int val = sudoku.getValue(r, c);
             if (val == 0) std::cout << ". ";
-            else if (val <= 9) std::cout << val << " ";
-            else std::cout << static_cast<char>('A' + val - 10) << " ";
+            else std::cout << Sudoku::valueSymbol(val) << " ";
         }
         std::cout << '\n';
     }
 }
 
+// Number of values in a candidate mask
+inline int countBits(Sudoku::Mask mask) {
+    return __builtin_popcountll(mask);
+}
+
+// Smallest value (1-based) in a non-empty candidate mask
+inline int lowestValue(Sudoku::Mask mask) {
+    return __builtin_ctzll(mask) + 1;
+}
+
+// Cell indices (row * size + col) of every unit: size rows, then size
+// columns, then size boxes, each listing size cells.
+inline std::vector<int> buildUnits(const Sudoku& sudoku) {
+    int size = sudoku.getSize();
+    int boxSize = sudoku.getBoxSize();
+    std::vector<int> units(3 * size * size);
+    for (int u = 0; u < size; ++u)
+        for (int k = 0; k < size; ++k) {
+            units[u * size + k] = u * size + k;
+            units[(size + u) * size + k] = k * size + u;
+            int row = (u / boxSize) * boxSize + k / boxSize;
+            int col = (u % boxSize) * boxSize + k % boxSize;
+            units[(2 * size + u) * size + k] = row * size + col;
+        }
+    return units;
+}
+
+// Cells sharing a row, column or box with each cell, numPeers per cell
+inline std::vector<int> buildPeers(const Sudoku& sudoku, int& numPeers) {
+    int size = sudoku.getSize();
+    int boxSize = sudoku.getBoxSize();
+    numPeers = 2 * (size - 1) + (boxSize - 1) * (boxSize - 1);
+
+    // Row by row, so that each list stays in ascending cell order
+    std::vector<int> peers(size * size * numPeers);
+    for (int cell = 0; cell < size * size; ++cell) {
+        int r = cell / size, c = cell % size;
+        int* out = &peers[cell * numPeers];
+        for (int orow = 0; orow < size; ++orow) {
+            if (orow == r) {
+                for (int ocol = 0; ocol < size; ++ocol)
+                    if (ocol != c) *out++ = orow * size + ocol;
+            } else if (orow / boxSize == r / boxSize) {
+                for (int ocol = 0; ocol < size; ++ocol)
+                    if (ocol == c || ocol / boxSize == c / boxSize) *out++ = orow * size + ocol;
+            } else {
+                *out++ = orow * size + c;
+            }
+        }
+    }
+    return peers;
+}
+
+// Givens that already clash can never lead to a valid solution
+inline bool hasConsistentGivens(const Sudoku& sudoku) {
+    int size = sudoku.getSize();
+    for (int r = 0; r < size; ++r)
+        for (int c = 0; c < size; ++c) {
+            int val = sudoku.getValue(r, c);
+            if (val != 0 && !sudoku.isValid(r, c, val)) return false;
+        }
+    return true;
+}
 
 }
@@ -8,6 +8,10 @@ struct ParsedArgs {
     int mode = 0;
     int numThreads = 2;
     int writeToFile = 0;
+    int propagation = 0;   // 0 off, 1 pre-pass, 2 pre-pass + every search node
+    std::string modelFile = "../selector_model.txt";   // auto mode (-m 10)
+    std::string valueOrder = "ascending";   // ascending, lcv, frequency or random
+    std::string restarts = "none";          // none, luby or geometric
     bool valid = false;
 };
 
@@ -0,0 +1,56 @@
+//include/solver/AdaptiveSolver.hpp
+#pragma once
+
+#include "SolverBase.hpp"
+#include "SelectionModel.hpp"
+#include <map>
+#include <string>
+#include <utility>
+
+// Picks the engine and thread count per puzzle from a SelectionModel, then
+// runs it on the board reduced by the feature pass. Without a model, or
+// when it has no candidate for the puzzle, defaultEngine() decides.
+// Engines are created on first use and kept for later puzzles.
+class AdaptiveSolver : public SolverBase {
+public:
+    // numThreads caps the thread count of the selected configuration
+    AdaptiveSolver(int numThreads, SelectionModel model);
+    explicit AdaptiveSolver(int numThreads) : AdaptiveSolver(numThreads, SelectionModel()) {}
+
+    bool solve(Sudoku& sudoku) override;
+    // Both go to the engine solve would select, on the propagated board
+    std::uint64_t countSolutions(const Sudoku& sudoku, std::uint64_t limit) override;
+    std::uint64_t enumerate(const Sudoku& sudoku, const SolutionCallback& onSolution) override;
+    std::unique_ptr<SolverBase> clone() const override;
+    // The selection may pick a multi-threaded configuration
+    bool hasIntraPuzzleParallelism() const override { return numThreads_ > 1; }
+
+    // Engines the model can name, nullptr for an unknown one
+    static std::unique_ptr<SolverBase> makeEngine(const std::string& name, int numThreads);
+    static bool isKnownEngine(const std::string& name);
+
+    // Single-threaded engine for a puzzle that propagation did not finish:
+    // Bitboard on 9x9, DLX otherwise. Both stay within a few times the
+    // fastest engine on boards that need search, where the row-major ones
+    // can take seconds; a model fitted on the target machine can do better.
+    static const char* defaultEngine(const PuzzleFeatures& features);
+
+    struct Selection {
+        std::string engine;     // empty when propagation settled the puzzle
+        int numThreads = 0;
+        PuzzleFeatures features;
+        double overheadMs = 0.0;   // feature pass and model evaluation
+    };
+    const Selection& getLastSelection() const { return lastSelection; }
+
+private:
+    int numThreads_;
+    SelectionModel model;
+    ConstraintPropagator propagator;
+    std::map<std::pair<std::string, int>, std::unique_ptr<SolverBase>> engines;
+    Selection lastSelection;
+
+    // Feature pass and selection into lastSelection; reduced receives the
+    // propagated board. nullptr if propagation settled the puzzle.
+    SolverBase* select(const Sudoku& sudoku, Sudoku& reduced);
+};
@@ -2,19 +2,108 @@
 #pragma once
 
 #include "SolverBase.hpp"
+#include "ConstraintPropagator.hpp"
+#include <cstdint>
+#include <random>
 
 class BacktrackingSolver : public SolverBase {
 public:
+    // RowMajor: fill empty cells in reading order, trying values 1..N
+    // MinimumRemaining: always branch on the cell with the fewest candidates
+    enum class CellOrder { RowMajor, MinimumRemaining };
+
     bool solve(Sudoku& sudoku) override;
-    bool solveAll(Sudoku& sudoku, std::vector<Sudoku>& allSolutions) override;
-    explicit BacktrackingSolver(int numThreads);
-    BacktrackingSolver() : BacktrackingSolver(1) {} 
+    std::uint64_t enumerate(const Sudoku& sudoku, const SolutionCallback& onSolution) override;
+    std::uint64_t countSolutions(const Sudoku& sudoku, std::uint64_t limit) override;
+    explicit BacktrackingSolver(int numThreads, CellOrder order = CellOrder::RowMajor);
+    BacktrackingSolver() : BacktrackingSolver(1) {}
     std::unique_ptr<SolverBase> clone() const override {
         return std::make_unique<BacktrackingSolver>(*this);
     }
 
+    // Number of values placed during the last solve / enumerate / countSolutions
+    std::uint64_t getNodeCount() const override { return nodeCount; }
+
+    // Every ValueOrder is supported. LeastConstraining counts, for each
+    // value, the open peers that still have it as a candidate.
+    bool setValueOrder(ValueOrder order, unsigned seed = 1) override;
+
+    // Attempts after the first break ties between fewest-candidate cells
+    // and between equally scored values at random; the row-major search,
+    // which has no cell to choose, tries values in random order instead
+    // when no value order is set
+    bool setRestartPolicy(const RestartPolicy& policy) override {
+        if (!policy.valid()) return false;
+        restartPolicy = policy;
+        return true;
+    }
+    int getRestartCount() const override { return restarts; }
+
+    // Run ConstraintPropagator after every placement, incrementally from
+    // the placed cell. For a single pass in front of the search, wrap the
+    // solver in PropagatingSolver instead.
+    void setNodePropagation(bool enabled) { nodePropagation = enabled; }
+
 private:
+    CellOrder order;
+    ValueOrderer valueOrderer;
+    std::uint64_t nodeCount = 0;
+    bool nodePropagation = false;
+
+    RestartPolicy restartPolicy;
+    int restarts = 0;
+    std::uint64_t nodeBudget = 0;      // 0: unlimited
+    bool budgetSpent = false;
+    bool randomTieBreak = false;
+    std::minstd_rand tieBreak;
+    static constexpr int TieBreakSpan = 64;   // value scores scale by it for random ties
+    bool overBudget();
+    ConstraintPropagator propagator;
+
+    // What a complete board means to the running search: solve stops at
+    // the first one, enumerate streams them to a callback, countSolutions
+    // counts up to its limit
+    struct Enumeration {
+        const SolutionCallback* onSolution = nullptr;
+        std::uint64_t found = 0;
+        std::uint64_t limit = 1;
+    };
+    Enumeration enumeration;
+
+    std::uint64_t run(Sudoku& board, const Enumeration& mode);
+    bool recordSolution(const Sudoku& board);
+
+    bool propagateNode(Sudoku& board, int cell);
+
     bool backtrack(Sudoku& board, const std::vector<std::pair<int, int>>& emptyCells, size_t index);
-    void backtrackAll(Sudoku& board, const std::vector<std::pair<int, int>>& emptyCells,
-                      size_t index, std::vector<Sudoku>& solutions);
+
+    // Non-ascending value orders. Each search level writes its sorted
+    // values to its own size-long slice of orderedValues; givenCount
+    // holds how often each value appears among the givens.
+    std::vector<int> orderedValues;
+    std::vector<int> givenCount;
+    void initValueOrder(const Sudoku& board);
+    int orderValues(const Sudoku& board, int cell, Sudoku::Mask mask, int* values);
+
+    // Minimum-remaining-values search state. candidates holds the legal
+    // values of every open cell and is narrowed incrementally on each
+    // placement; trail records the removed bits so they can be restored.
+    struct TrailEntry {
+        int cell;
+        Sudoku::Mask removed;
+    };
+    int size = 0;
+    int numPeers = 0;
+    std::vector<int> peers;              // numPeers entries per cell
+    std::vector<Sudoku::Mask> candidates;
+    std::vector<int> openCells;          // [0, openCount) are still empty
+    std::vector<TrailEntry> trail;
+
+    void ensurePeers(const Sudoku& board);
+    void initMRV(const Sudoku& board);
+    bool assign(Sudoku& board, int cell, int val);
+    bool strike(Sudoku& board, int cell, int val);
+    bool closeForced(Sudoku& board, size_t first, size_t& openCount);
+    void undo(Sudoku& board, int cell, size_t trailMark);
+    bool searchMRV(Sudoku& board, size_t openCount);
 };
@@ -2,14 +2,23 @@
 #pragma once
 
 #include "SolverBase.hpp"
+#include "ValueOrder.hpp"
 
 class BruteForceSolver : public SolverBase {
 public:
     bool solve(Sudoku& sudoku) override;
+    std::uint64_t countSolutions(const Sudoku& sudoku, std::uint64_t limit) override;
     explicit BruteForceSolver(int numThreads);
     BruteForceSolver() : BruteForceSolver(1) {} 
     std::unique_ptr<SolverBase> clone() const override {
         return std::make_unique<BruteForceSolver>(*this);
     }
 
+    bool setValueOrder(ValueOrder order, unsigned seed = 1) override {
+        valueOrderer = ValueOrderer(order, seed);
+        return true;
+    }
+
+private:
+    ValueOrderer valueOrderer;
 };
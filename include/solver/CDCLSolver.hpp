@@ -0,0 +1,39 @@
+//include/solver/CDCLSolver.hpp
+#pragma once
+
+#include "SolverBase.hpp"
+#include "SatCore.hpp"
+#include <vector>
+
+// Encodes the board as CNF and solves it with SatCore. Only candidates
+// left by the givens get a variable; each open cell and each value missing
+// from a unit gets an at-least-one clause plus at-most-one clauses:
+// pairwise for small groups (box pairs already covered by a row or column
+// are skipped), a sequential counter for large ones.
+class CDCLSolver : public SolverBase {
+public:
+    bool solve(Sudoku& sudoku) override;
+    // Solves again after blocking each model found with a clause that
+    // forbids its placements, until limit or Unsatisfiable
+    std::uint64_t countSolutions(const Sudoku& sudoku, std::uint64_t limit) override;
+    explicit CDCLSolver(int numThreads);
+    CDCLSolver() : CDCLSolver(1) {}
+    std::unique_ptr<SolverBase> clone() const override {
+        return std::make_unique<CDCLSolver>(*this);
+    }
+
+    // Size of the encoding and search effort of the last solve
+    int getNumVars() const { return core.getNumVars(); }
+    std::size_t getNumClauses() const { return core.getNumClauses(); }
+    std::uint64_t getConflicts() const { return core.getConflicts(); }
+    std::uint64_t getDecisions() const { return core.getDecisions(); }
+
+private:
+    SatCore core;
+    int size = 0;
+    std::vector<int> varOf;   // (cell * size + value - 1) -> variable, -1 if none
+
+    bool encode(const Sudoku& sudoku);
+    bool exactlyOne(const std::vector<SatCore::Lit>& lits);
+    bool atMostOne(const std::vector<SatCore::Lit>& lits);
+};
@@ -0,0 +1,27 @@
+//include/solver/CancellationToken.hpp
+#pragma once
+
+#include <atomic>
+
+// Cooperative stop signal polled by the search loops. A token created
+// with a parent also reports cancellation once the parent is cancelled,
+// so a solver can stop its own workers without losing an outer cancel.
+class CancellationToken {
+public:
+    CancellationToken() = default;
+    explicit CancellationToken(const CancellationToken* parent) : parent(parent) {}
+
+    CancellationToken(const CancellationToken&) = delete;
+    CancellationToken& operator=(const CancellationToken&) = delete;
+
+    void cancel() { cancelled.store(true, std::memory_order_relaxed); }
+    void reset() { cancelled.store(false, std::memory_order_relaxed); }
+
+    bool isCancelled() const {
+        return cancelled.load(std::memory_order_relaxed) || (parent && parent->isCancelled());
+    }
+
+private:
+    std::atomic<bool> cancelled{false};
+    const CancellationToken* parent = nullptr;
+};
@@ -0,0 +1,85 @@
+//include/solver/ConstraintPropagator.hpp
+#pragma once
+
+#include "core/Sudoku.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct PropagationResult {
+    bool consistent = true; // false when a contradiction was detected
+    int cellsFilled = 0;    // values written to the board
+};
+
+// Logical deduction without search: naked singles, hidden singles,
+// pointing pairs and box/line reduction, repeated until nothing changes.
+// Only the values whose candidates changed in a unit are revisited, so
+// after the first pass a search can keep the propagator in step with its
+// board at the cost of what each placement touches.
+class ConstraintPropagator {
+public:
+    // Writes every forced value into sudoku. On a contradiction the cells
+    // filled so far are left in place (see getFilledCells) for the caller
+    // to discard or undo.
+    PropagationResult propagate(Sudoku& sudoku);
+
+    // Incremental use inside a search, after propagate() on its board:
+    // the search writes a value into cell and propagateFrom() draws the
+    // consequences of that cell alone. rollback() undoes every change
+    // since checkpoint(), clearing the cells filled on the board; the
+    // search clears its own cell.
+    struct Checkpoint {
+        std::size_t trail = 0;
+        std::size_t filled = 0;
+    };
+    PropagationResult propagateFrom(Sudoku& sudoku, int cell);
+    Checkpoint checkpoint() const { return {trail.size(), filledCells.size()}; }
+    void rollback(Sudoku& sudoku, const Checkpoint& mark);
+
+    // Remaining candidates per cell (row * size + col) after the last call,
+    // including eliminations that are not visible on the board
+    const std::vector<Sudoku::Mask>& getCandidates() const { return candidates; }
+
+    // Cells (row * size + col) filled since the last propagate(), in
+    // placement order
+    const std::vector<int>& getFilledCells() const { return filledCells; }
+
+private:
+    int size = 0;
+    int boxSize = 0;
+    int numPeers = 0;
+    std::vector<int> peers;
+    std::vector<int> units;
+    std::vector<Sudoku::Mask> candidates;
+    std::vector<int> filledCells;
+
+    // Candidate masks as they were before each change, newest last
+    struct TrailEntry {
+        int cell;
+        Sudoku::Mask previous;
+    };
+    std::vector<TrailEntry> trail;
+
+    // Work left for drain(): cells down to one candidate, and per unit
+    // (rows, columns, boxes as numbered in SudokuUtils::buildUnits) the
+    // values whose candidate cells changed, for the hidden singles and
+    // for the box/line eliminations
+    std::vector<int> nakedQueue;
+    std::vector<Sudoku::Mask> hiddenDirty;
+    std::vector<Sudoku::Mask> reductionDirty;
+    std::vector<int> hiddenQueue;
+    std::vector<int> reductionQueue;
+
+    void init(const Sudoku& sudoku);
+    void touch(int cell, Sudoku::Mask values);
+    void clearPending();
+    void setCandidates(int cell, Sudoku::Mask mask);
+    bool strikePeers(int cell, Sudoku::Mask bit);
+    bool place(Sudoku& sudoku, int cell, int val);
+    bool eliminate(int cell, Sudoku::Mask bits);
+    bool drain(Sudoku& sudoku);
+
+    bool hiddenSingles(Sudoku& sudoku, int unit, Sudoku::Mask values);
+    bool pointingPairs(int box, Sudoku::Mask values);
+    bool boxLineReduction(int line, Sudoku::Mask values);
+};
@@ -2,45 +2,72 @@
 #pragma once
 
 #include "SolverBase.hpp"
+#include "DancingLinks.hpp"
+#include "ConstraintPropagator.hpp"
 #include "core/Sudoku.hpp"
+#include <memory>
 
 class DLXSolver : public SolverBase {
 public:
     DLXSolver();
     bool solve(Sudoku& sudoku) override;
+    std::uint64_t countSolutions(const Sudoku& sudoku, std::uint64_t limit) override;
+    std::uint64_t enumerate(const Sudoku& sudoku, const SolutionCallback& onSolution) override;
     explicit DLXSolver(int numThreads);
     std::unique_ptr<SolverBase> clone() const override {
         return std::make_unique<DLXSolver>(*this);
     }    
 
+    // Rows tried during the last solve / countSolutions, over all attempts
+    std::uint64_t getNodeCount() const override { return spentNodes + matrix.getNodeCount(); }
+
+    // Attempts after the first break ties between smallest columns at random
+    bool setRestartPolicy(const RestartPolicy& policy) override {
+        if (!policy.valid()) return false;
+        restartPolicy = policy;
+        return true;
+    }
+    int getRestartCount() const override { return restarts; }
+
+    // Every ValueOrder is supported, as the order of the rows of the chosen
+    // column. LeastConstraining counts the rows left in the other three
+    // columns of a row; Frequency ranks values by how often they are given.
+    bool setValueOrder(ValueOrder order, unsigned seed = 1) override;
+
+    // Exact-cover matrix of the open part of a board: a row for each
+    // candidate left in each open cell, over the constraints the givens
+    // leave unsatisfied, numbered densely in the order of the full matrix.
+    // Candidates come from the board, or from candidates (one mask per
+    // cell, row * size + col) once propagation has narrowed them. A board
+    // that keeps over a quarter of the rows gets a copy of
+    // exactCoverTemplate with the givens committed instead, which is
+    // cheaper to set up and searches the same. Row IDs are (row * size + col) * size + digit - 1.
+    // Returns false when two givens clash.
+    static bool buildExactCoverMatrix(DancingLinks& matrix, const Sudoku& board,
+                                      const std::vector<Sudoku::Mask>* candidates = nullptr);
+
+    // Full exact-cover matrix (all size^3 rows, no givens) for a board
+    // size. Built once per size and shared.
+    static std::shared_ptr<const DancingLinks> exactCoverTemplate(int size);
+
+    // Runs ConstraintPropagator before building the matrix, so that the
+    // cells it fills and the candidates it eliminates get no rows
+    void setPropagation(bool enabled) { propagation = enabled; }
+
 private:
-    struct Node {
-        Node* L; Node* R; Node* U; Node* D;
-        Node* C; // column header
-        int rowID;
-        int colID;
-        int nodeCount;
-    };
-
-    struct ColumnNode : Node {
-        int size; // number of nodes in column
-        const char* name;
-    };
-
-    ColumnNode* header;
-    int nRows;
-    int nCols;
-    std::vector<Node> nodes;
-    std::vector<ColumnNode> columnNodes;
-
-    std::vector<Node*> solution;
-
-    void buildExactCoverMatrix(const Sudoku& sudoku);
-    void cover(ColumnNode* c);
-    void uncover(ColumnNode* c);
-    bool search(int k);
-    int sudokuToIndex(int row, int col, int num) const;
-    Sudoku sudoku_; // Save the currently solved Sudoku 
+    DancingLinks matrix;
+    ValueOrder valueOrder = ValueOrder::Ascending;
+    unsigned valueOrderSeed = 1;
+    RestartPolicy restartPolicy;
+    int restarts = 0;
+    std::uint64_t spentNodes = 0;   // nodes of the attempts before the last one
+
+    bool propagation = false;
+    ConstraintPropagator propagator;
+    Sudoku start;   // the board the matrix was built from
+
+    bool loadGivens(const Sudoku& sudoku);
+    void fillBoard(Sudoku& sudoku, const std::vector<int>& rowIDs) const;
 
     int size;     // Sudoku size
     int boxSize;  
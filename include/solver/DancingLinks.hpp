@@ -0,0 +1,132 @@
+//include/solver/DancingLinks.hpp
+#pragma once
+
+#include "core/AlignedAllocator.hpp"
+#include "CancellationToken.hpp"
+#include "ValueOrder.hpp"
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+// Exact-cover matrix for Algorithm X, stored as parallel int32 arrays
+// instead of pointer-linked nodes. Index 0 is the root, indices
+// 1..numColumns are the column headers and data nodes follow, four
+// (or however many columns a row touches) per row, contiguously.
+class DancingLinks {
+public:
+    // Empty matrix with numColumns columns, room for reserveNodes data nodes
+    // and for row IDs below numRowIDs, trying rows in ascending order
+    void init(int numColumns, std::size_t reserveNodes = 0, int numRowIDs = 0);
+
+    // Appends a row covering the given 0-based columns
+    void addRow(int rowID, const int* columns, int count);
+
+    // Commits to a row up front (e.g. a given) by covering all of its
+    // columns. Returns false if the row was already knocked out by an
+    // earlier selection, i.e. the two clash.
+    bool selectRow(int rowID);
+    // Reverts the latest selectRow of rowID
+    void unselectRow(int rowID);
+
+    // First data node of a row, or -1 if the row is not in the matrix
+    int getRowNode(int rowID) const {
+        return rowID < static_cast<int>(rowNode.size()) ? rowNode[rowID] : -1;
+    }
+
+    // Order in which search / enumerate try the rows of the chosen column.
+    // Ascending keeps insertion order; LeastConstraining tries first the
+    // rows whose other columns hold the fewest rows; Frequency tries first
+    // the rows with the highest priority[rowID]; Random shuffles them with
+    // a generator seeded by seed. Copies of the matrix keep the setting.
+    void setRowOrder(ValueOrder order, std::vector<int> priority = {}, unsigned seed = 1);
+
+    // Limits search / enumerate to budget rows (0: unlimited). A run that
+    // hits it gives up like a cancelled one and reports outOfBudget().
+    void setNodeBudget(std::uint64_t budget) { nodeBudget = budget; }
+    bool outOfBudget() const { return budgetSpent; }
+
+    // Breaks ties between smallest columns at random instead of taking the
+    // leftmost one; the heuristic itself is unchanged
+    void setRandomTieBreak(bool enabled, unsigned seed = 1);
+
+    // Algorithm X with the smallest-column heuristic. On success the chosen
+    // row IDs are available through getSolution(). Gives up (returning
+    // false) as soon as stop is cancelled.
+    bool search(const CancellationToken* stop = nullptr);
+
+    // Receives the row IDs of each exact cover found (rows committed with
+    // selectRow excluded); returning false ends the enumeration
+    using SolutionVisitor = std::function<bool(const std::vector<int>& rowIDs)>;
+
+    // Visits the exact covers one after another until onSolution or stop
+    // ends it and returns how many were visited. As with search, stopping
+    // on a solution leaves its rows covered.
+    std::uint64_t enumerate(const SolutionVisitor& onSolution, const CancellationToken* stop = nullptr);
+
+    // Column with the fewest rows among the uncovered ones, the leftmost on
+    // ties, as a handle for the accessors below; 0 once every column is
+    // covered. Found through the size buckets in time independent of the
+    // number of columns.
+    int chooseColumn() const;
+    int getColumnSize(int column) const { return S[column]; }
+    void getColumnRows(int column, std::vector<int>& rowIDs) const;
+
+    const std::vector<int>& getSolution() const { return solution; }
+    std::uint64_t getNodeCount() const { return nodeCount; }
+    int getNumColumns() const { return nCols; }
+    int getNumNodes() const { return static_cast<int>(L.size()) - nCols - 1; }
+    std::size_t getMemoryBytes() const;
+
+private:
+    int nCols = 0;
+
+    AlignedVector<std::int32_t> L, R, U, D; // links
+    AlignedVector<std::int32_t> C;          // column header of each node
+    AlignedVector<std::int32_t> rowOf;      // row ID of each data node
+    AlignedVector<std::int32_t> S;          // node count of each column
+    std::vector<std::int32_t> rowNode;      // first node of each row ID
+
+    std::vector<int> solution;
+    std::uint64_t nodeCount = 0;
+
+    // Uncovered columns grouped by size: bit c of bucket s is set while
+    // column c is uncovered and holds s rows, and bit w of the bucket's
+    // summary while its word w is non-zero. Built by the first column
+    // choice after init, so that building the matrix and committing the
+    // givens skip the bookkeeping; from then on cover / uncover move
+    // columns between buckets as their sizes change.
+    int maxColumnRows = 0;   // bound on any column size, covers undone
+    mutable bool bucketsLive = false;
+    mutable int bucketWords = 0;
+    mutable int summaryWords = 0;
+    mutable std::vector<std::uint64_t> bucketBits;
+    mutable std::vector<std::uint64_t> bucketSummary;
+    mutable std::vector<int> bucketCount;
+    void buildBuckets() const;
+    void bucketInsert(int c, int size) const;
+    void bucketErase(int c, int size) const;
+    int bucketColumn(int size, int rank) const;
+
+    void cover(int c);
+    void uncover(int c);
+    const CancellationToken* stopFlag = nullptr;
+    const SolutionVisitor* visitor = nullptr;   // null: stop at the first cover
+    std::uint64_t visited = 0;
+
+    ValueOrder rowOrder = ValueOrder::Ascending;
+    std::vector<int> rowPriority;
+    std::minstd_rand rowShuffle;
+    // (score, node) of the rows being tried, one slice per search level
+    std::vector<std::pair<int, int>> orderedRows;
+
+    std::uint64_t nodeBudget = 0;
+    bool budgetSpent = false;
+    bool randomTieBreak = false;
+    std::minstd_rand tieBreak;
+    int chooseColumnRandomly();
+
+    bool searchLevel();
+    bool tryRow(int r);
+    void orderColumnRows(int c, std::size_t begin);
+};
@@ -0,0 +1,30 @@
+//include/solver/FixedSizeSolver.hpp
+#pragma once
+
+#include "SolverBase.hpp"
+#include "ValueOrder.hpp"
+#include <vector>
+
+// Backtracking on compile-time sized boards (see core/FixedSudoku.hpp).
+// Sizes without a specialization fall back to BacktrackingSolver.
+class FixedSizeSolver : public SolverBase {
+public:
+    bool solve(Sudoku& sudoku) override;
+    std::uint64_t countSolutions(const Sudoku& sudoku, std::uint64_t limit) override;
+    explicit FixedSizeSolver(int numThreads);
+    FixedSizeSolver() : FixedSizeSolver(1) {}
+    std::unique_ptr<SolverBase> clone() const override {
+        return std::make_unique<FixedSizeSolver>(*this);
+    }
+
+    bool setValueOrder(ValueOrder order, unsigned seed = 1) override;
+
+    // Values placed during the last solve / countSolutions
+    std::uint64_t getNodeCount() const override { return nodeCount; }
+
+private:
+    std::uint64_t nodeCount = 0;
+    ValueOrderer valueOrderer;
+    unsigned valueOrderSeed = 1;    // for the fallback
+    std::vector<int> orderedValues; // N values per depth for non-ascending orders
+};
@@ -0,0 +1,64 @@
+//include/solver/LaneBatchSolver.hpp
+#pragma once
+
+#include "SolverBase.hpp"
+#include "BitboardSolver.hpp"
+#include <cstdint>
+#include <vector>
+
+// Batch engine for many independent 9x9 puzzles: sixteen puzzles sit in the
+// 16-bit lanes of one set of vectors, a vector per cell holding each lane's
+// candidate mask, and naked and hidden singles run for all of them in
+// lockstep. A lane whose puzzle is solved or proven unsolvable is refilled
+// with the next puzzle of the chunk. A lane where propagation stalls saves
+// its state on its own stack and guesses on a cell with the fewest
+// candidates, so it keeps running the shared kernel; a dead end restores
+// the saved state without the guessed digit. Reach it through
+// solveBatch(); a single solve() is a batch of one, and other sizes go to
+// a scalar BitboardSolver, which falls back to DLX.
+class LaneBatchSolver : public SolverBase {
+public:
+    static constexpr int LaneCount = 16;
+
+    // How the boards of the last batch chunk, or the last solve(), ended
+    struct Stats {
+        std::uint64_t rounds = 0;          // lockstep propagation rounds
+        std::uint64_t guesses = 0;         // branches taken inside a lane
+        std::uint64_t solvedInLanes = 0;
+        std::uint64_t rejectedInLanes = 0; // no solution
+        std::uint64_t fallbacks = 0;       // not 9x9, solved by the fallback
+    };
+
+    // Kernel picks the instruction set of the lane kernel the same way as
+    // for BitboardSolver; here Auto means Avx2 where the CPU has it, since
+    // a 256-bit vector holds all sixteen lanes of a cell
+    explicit LaneBatchSolver(int numThreads,
+                             BitboardSolver::Kernel kernel = BitboardSolver::Kernel::Auto);
+    LaneBatchSolver() : LaneBatchSolver(1) {}
+
+    bool solve(Sudoku& sudoku) override;
+    std::uint64_t countSolutions(const Sudoku& sudoku, std::uint64_t limit) override;
+    std::unique_ptr<SolverBase> clone() const override {
+        return std::make_unique<LaneBatchSolver>(*this);
+    }
+    void setCancellationToken(std::shared_ptr<CancellationToken> token) override {
+        fallback.setCancellationToken(token);
+        SolverBase::setCancellationToken(std::move(token));
+    }
+
+    BitboardSolver::Kernel getKernel() const { return kernel; }
+    const Stats& getLastStats() const { return stats; }
+
+protected:
+    void solveBatchChunk(Sudoku* const* boards, std::size_t count, std::uint8_t* solved) override;
+    std::size_t batchGrain() const override { return 16 * LaneCount; }
+    std::size_t batchMinGrain() const override { return LaneCount; }
+
+private:
+    BitboardSolver::Kernel kernel;
+    BitboardSolver fallback;
+    Stats stats;
+    // Guess stack of each lane, kept across chunks so that its storage is
+    // reused: one frame of 81 candidate masks per open guess
+    std::vector<std::uint16_t> saved[LaneCount];
+};
@@ -1,6 +1,8 @@
 //include/solver/ParallelBacktrackingSolver.hpp
 #pragma once
 #include "SolverBase.hpp"
+#include "SolverSession.hpp"
+#include "BacktrackingSolver.hpp"
 #include "core/Sudoku.hpp"
 #include <taskflow/taskflow.hpp>
 #include <vector>
@@ -8,25 +10,28 @@
 class ParallelBacktrackingSolver : public SolverBase {
 public:
     ParallelBacktrackingSolver() : ParallelBacktrackingSolver(2) {} 
-    ParallelBacktrackingSolver(int numThreads = 2);
+    // Without a session the process-wide one for numThreads is used
+    ParallelBacktrackingSolver(int numThreads = 2, std::shared_ptr<SolverSession> session = nullptr);
 
     bool solve(Sudoku& sudoku) override;
-    bool solveAll(Sudoku& sudoku, std::vector<Sudoku>& allSolutions) override;
-    std::unique_ptr<SolverBase> clone() const override {
-        return std::make_unique<ParallelBacktrackingSolver>(*this);
-    }     
-private:
-    int numThreads_;
-
-    bool parallelBacktrack(Sudoku& board, 
-                           const std::vector<std::pair<int, int>>& emptyCells,
-                           size_t index);
+    std::uint64_t countSolutions(const Sudoku& sudoku, std::uint64_t limit) override;
+    // Solutions reach onSolution through a bounded SolutionStream; the
+    // workers block while the calling thread is behind
+    std::uint64_t enumerate(const Sudoku& sudoku, const SolutionCallback& onSolution) override;
+    std::unique_ptr<SolverBase> clone() const override;
+    bool hasIntraPuzzleParallelism() const override { return session_->getNumThreads() > 1; }
+    // Every worker tries the values in this order
+    bool setValueOrder(ValueOrder order, unsigned seed = 1) override;
 
-    void parallelBacktrackAll(Sudoku& board,
-                              const std::vector<std::pair<int, int>>& emptyCells,
-                              size_t index,
-                              std::vector<Sudoku>& solutions,
-                              tf::Taskflow& taskflow,
-                              tf::Executor& executor);
+protected:
+    // Batch workers already keep every core busy with whole puzzles, so
+    // each board of a chunk is solved by a single-threaded BacktrackingSolver
+    void solveBatchChunk(Sudoku* const* boards, std::size_t count, std::uint8_t* solved) override;
 
+private:
+    int numThreads_;
+    std::shared_ptr<SolverSession> session_;
+    ValueOrder valueOrder = ValueOrder::Ascending;
+    unsigned valueOrderSeed = 1;
+    std::unique_ptr<BacktrackingSolver> sequential;   // created by the first batch chunk
 };
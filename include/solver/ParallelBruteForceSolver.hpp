@@ -2,18 +2,33 @@
 #pragma once
 
 #include "SolverBase.hpp"
+#include "SolverSession.hpp"
+#include "BruteForceSolver.hpp"
 #include "core/Sudoku.hpp"
 #include <taskflow/taskflow.hpp>
 
 class ParallelBruteForceSolver : public SolverBase {
 public:
-    ParallelBruteForceSolver(int numThreads = 2);
+    // Without a session the process-wide one for numThreads is used
+    ParallelBruteForceSolver(int numThreads = 2, std::shared_ptr<SolverSession> session = nullptr);
     ParallelBruteForceSolver() : ParallelBruteForceSolver(2) {} 
 
     bool solve(Sudoku& sudoku) override;
-    std::unique_ptr<SolverBase> clone() const override {
-        return std::make_unique<ParallelBruteForceSolver>(*this);
-    }  
+    std::uint64_t countSolutions(const Sudoku& sudoku, std::uint64_t limit) override;
+    std::unique_ptr<SolverBase> clone() const override;
+    bool hasIntraPuzzleParallelism() const override { return session_->getNumThreads() > 1; }
+    // Every worker tries the values in this order
+    bool setValueOrder(ValueOrder order, unsigned seed = 1) override;
+
+protected:
+    // Batch workers already keep every core busy with whole puzzles, so
+    // each board of a chunk is solved by a single-threaded BruteForceSolver
+    void solveBatchChunk(Sudoku* const* boards, std::size_t count, std::uint8_t* solved) override;
+
 private:
     int numThreads_;
+    std::shared_ptr<SolverSession> session_;
+    ValueOrder valueOrder = ValueOrder::Ascending;
+    unsigned valueOrderSeed = 1;
+    std::unique_ptr<BruteForceSolver> sequential;   // created by the first batch chunk
 };
@@ -2,17 +2,28 @@
 #pragma once
 
 #include "SolverBase.hpp"
+#include "DancingLinks.hpp"
+#include "DLXSolver.hpp"
+#include "SolverSession.hpp"
 #include "core/Sudoku.hpp"
+#include "core/ScratchArena.hpp"
 #include <mutex>
 #include <vector>
-#include <deque>       // change to use deque
 #include <memory>
-#include <string>
 #include <taskflow/taskflow.hpp>
 
 class ParallelDLXSolver : public SolverBase {
 public:
-    explicit ParallelDLXSolver(int numThreads);
+    // When a task hands its branches to new subtasks instead of searching
+    // them itself
+    struct SplitLimits {
+        int maxDepth = 8;        // rows committed below the givens
+        int minColumnSize = 2;   // splitting a single row gains nothing
+        int tasksPerWorker = 4;  // stop splitting once this many are queued per idle worker
+    };
+
+    // Without a session the process-wide one for numThreads is used
+    explicit ParallelDLXSolver(int numThreads, std::shared_ptr<SolverSession> session = nullptr);
     
     // Change the default constructor to an explicit call to the parameterized constructor
     ParallelDLXSolver() : ParallelDLXSolver(2) {}
@@ -22,63 +33,66 @@ public:
     ParallelDLXSolver& operator=(const ParallelDLXSolver&) = delete;
 
     bool solve(Sudoku& sudoku) override;
+    std::uint64_t countSolutions(const Sudoku& sudoku, std::uint64_t limit) override;
+    // Solutions arrive in the same order as from DLXSolver::enumerate
+    std::uint64_t enumerate(const Sudoku& sudoku, const SolutionCallback& onSolution) override;
     std::unique_ptr<SolverBase> clone() const override;
+    bool hasIntraPuzzleParallelism() const override { return session_->getNumThreads() > 1; }
+
+    void setSplitLimits(const SplitLimits& limits) { splitLimits = limits; }
+
+protected:
+    // Batch workers already keep every core busy with whole puzzles, so
+    // each board of a chunk is solved by a single-threaded DLXSolver
+    void solveBatchChunk(Sudoku* const* boards, std::size_t count, std::uint8_t* solved) override;
 
 private:
     int N;          // add Sudoku size N (9,16,25...)
-    int boxSize;    // add subblock (sqrt(N))
 
     int numThreads_;
+    std::shared_ptr<SolverSession> session_;
+    SplitLimits splitLimits;
     std::mutex solutionMutex;
-
-    struct ColumnNode;
-
-    struct Node {
-        Node* left;
-        Node* right;
-        Node* up;
-        Node* down;
-        ColumnNode* column;
-        int rowID;
-
-        Node() : left(this), right(this), up(this), down(this), column(nullptr), rowID(-1) {}
+    std::unique_ptr<DLXSolver> sequential;   // created by the first batch chunk
+
+    // Matrix of the open cells (DLXSolver::buildExactCoverMatrix). Tasks
+    // start from a flat copy of it and replay their prefix of selected
+    // rows by ID.
+    DancingLinks matrix;
+
+    // State of one executor worker, reused across tasks and solves so that
+    // the steady-state search does not touch the heap: a snapshot buffer
+    // the base matrix is copied into (a plain memcpy into existing
+    // storage), the task's current rows, and an arena holding the prefixes
+    // of the tasks it spawns until the search is over
+    struct WorkerScratch {
+        DancingLinks matrix;
+        std::vector<int> path;
+        std::vector<int> rows;
+        ScratchArena prefixes;
     };
+    std::vector<WorkerScratch> workers;
+    std::vector<int> solutionRows;   // row IDs, (row * N + col) * N + num
 
-    struct ColumnNode : public Node {
-        int size;
-        std::string name;
-
-        ColumnNode() : size(0), name(""), Node() {
-            column = this;
-        }
+    struct SearchState;
+    struct EnumerationTask;
 
-        ColumnNode(const std::string& n) : size(0), name(n) {
-            column = this;
-        }
+    // Rows of a spawned task, in the arena of the worker that spawned it
+    struct Prefix {
+        const int* rows = nullptr;
+        int length = 0;
     };
 
-    ColumnNode* header;
-    int nRows;
-    int nCols;
-
-    std::deque<Node> nodes;               // deque<Node>
-    std::vector<ColumnNode> columnNodes;
+    bool loadGivens(const Sudoku& sudoku);
+    std::uint64_t parallelSearch(std::uint64_t limit);
+    void searchTask(tf::Subflow& subflow, Prefix prefix, SearchState& state);
+    void spawnTask(tf::Subflow& subflow, WorkerScratch& scratch, SearchState& state);
+    void recordSolution(const std::vector<int>& prefix, const std::vector<int>& rest, SearchState& state);
 
-    struct RowInfo {
-        int row, col, num;
-    };
-    std::vector<RowInfo> rowInfos;
-    std::vector<RowInfo> solutionRows;
-
-    void buildExactCoverMatrix(const Sudoku& sudoku);
-    void cover(ColumnNode* c);
-    void uncover(ColumnNode* c);
-    bool search(int k, std::vector<Node*>& currentSolution);
-    bool parallelSearch(int k);
+    std::vector<std::vector<int>> splitFrontier(std::size_t target);
+    void collectPrefixes(DancingLinks& scratch, std::vector<int>& prefix, int depth,
+                         std::vector<std::vector<int>>& prefixes);
 
     void extractSolutionToSudoku(Sudoku& sudoku);
-
-    int sudokuToIndex(int row, int col, int num) const;
-    void cloneFrom(const ParallelDLXSolver& other);
-    bool searchFromRowID(int rowID, std::vector<Node*>& outSolution);
+    void fillBoard(Sudoku& sudoku, const int* rowIDs, std::size_t count) const;
 };
@@ -0,0 +1,54 @@
+//include/solver/PortfolioSolver.hpp
+#pragma once
+
+#include "SolverBase.hpp"
+#include "SolverSession.hpp"
+#include <functional>
+#include <string>
+#include <vector>
+
+// Races several engines on copies of the same board, one worker each, and
+// keeps the first definite answer: a solution, or a proof that there is
+// none. The other engines are then cancelled through a shared token and
+// solve returns once all of them have unwound. countSolutions races the
+// same way; enumerate, whose solutions must come from a single engine,
+// tries the engines in turn.
+class PortfolioSolver : public SolverBase {
+public:
+    // Races one worker per engine; numThreads is only reported
+    explicit PortfolioSolver(int numThreads);
+    PortfolioSolver() : PortfolioSolver(1) {}
+
+    void addEngine(const std::string& name, std::unique_ptr<SolverBase> engine);
+
+    bool solve(Sudoku& sudoku) override;
+    // The first engine with a count wins; CountUnsupported if none has one
+    std::uint64_t countSolutions(const Sudoku& sudoku, std::uint64_t limit) override;
+    std::uint64_t enumerate(const Sudoku& sudoku, const SolutionCallback& onSolution) override;
+    std::unique_ptr<SolverBase> clone() const override;
+    bool hasIntraPuzzleParallelism() const override { return engines.size() > 1; }
+
+    // Engine that answered the last solve / countSolutions / enumerate,
+    // empty if none did
+    const std::string& getLastWinner() const { return lastWinner; }
+
+private:
+    struct Engine {
+        std::string name;
+        std::unique_ptr<SolverBase> solver;
+    };
+    std::vector<Engine> engines;
+    std::string lastWinner;
+
+    // Own workers: engines such as ParallelDLXSolver wait on the shared
+    // sessions, which must not happen from inside one of their workers
+    std::shared_ptr<SolverSession> racers;
+
+    struct Quiet {};
+    explicit PortfolioSolver(Quiet) {}
+
+    // Runs attempt(engine index, race token) for every engine at once and
+    // returns the index of the first that reports a definite answer, -1
+    // if none does; the others are cancelled through the race token
+    int race(const std::function<bool(std::size_t, const CancellationToken&)>& attempt);
+};
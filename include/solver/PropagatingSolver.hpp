@@ -0,0 +1,58 @@
+//include/solver/PropagatingSolver.hpp
+#pragma once
+
+#include "SolverBase.hpp"
+#include "ConstraintPropagator.hpp"
+
+// Runs ConstraintPropagator as a pre-pass and hands the reduced board to
+// the wrapped solver only when deduction alone does not finish it.
+class PropagatingSolver : public SolverBase {
+public:
+    explicit PropagatingSolver(std::unique_ptr<SolverBase> inner);
+
+    bool solve(Sudoku& sudoku) override;
+    std::uint64_t enumerate(const Sudoku& sudoku, const SolutionCallback& onSolution) override;
+    std::uint64_t countSolutions(const Sudoku& sudoku, std::uint64_t limit) override;
+    std::unique_ptr<SolverBase> clone() const override {
+        return std::make_unique<PropagatingSolver>(inner->clone());
+    }
+
+    // The wrapped solver does the searching, so it gets the token too
+    void setCancellationToken(std::shared_ptr<CancellationToken> token) override {
+        inner->setCancellationToken(token);
+        SolverBase::setCancellationToken(std::move(token));
+    }
+
+    bool setValueOrder(ValueOrder order, unsigned seed = 1) override {
+        return inner->setValueOrder(order, seed);
+    }
+    bool setRestartPolicy(const RestartPolicy& policy) override {
+        return inner->setRestartPolicy(policy);
+    }
+    int getRestartCount() const override {
+        return solvedWithoutSearch ? 0 : inner->getRestartCount();
+    }
+    std::uint64_t getNodeCount() const override {
+        return solvedWithoutSearch ? 0 : inner->getNodeCount();
+    }
+    bool hasIntraPuzzleParallelism() const override { return inner->hasIntraPuzzleParallelism(); }
+
+    // Outcome of the pre-pass of the last solve / enumerate / countSolutions
+    const PropagationResult& getLastResult() const { return lastResult; }
+    bool solvedByPropagation() const { return solvedWithoutSearch; }
+
+protected:
+    // Propagates every board of the chunk and hands the ones deduction
+    // does not finish to the wrapped solver's chunk, in its grain
+    void solveBatchChunk(Sudoku* const* boards, std::size_t count, std::uint8_t* solved) override;
+    std::size_t batchGrain() const override { return SolverBase::batchGrain(*inner); }
+    std::size_t batchMinGrain() const override { return SolverBase::batchMinGrain(*inner); }
+
+private:
+    std::unique_ptr<SolverBase> inner;
+    std::vector<Sudoku*> searchBoards;
+    std::vector<std::uint8_t> searchSolved;
+    ConstraintPropagator propagator;
+    PropagationResult lastResult;
+    bool solvedWithoutSearch = false;
+};
@@ -0,0 +1,63 @@
+//include/solver/RestartPolicy.hpp
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Restarts for a solve that ran into a bad early choice: each attempt gets
+// a node budget from the schedule and its own seed for tie-breaking, and a
+// new attempt starts from scratch once the budget is spent. Budgets must
+// grow without bound for the search to stay complete, see valid().
+struct RestartPolicy {
+    enum class Schedule {
+        None,       // one unbounded attempt
+        Luby,       // baseNodes * 1, 1, 2, 1, 1, 2, 4, 1, ...
+        Geometric   // baseNodes * growth^attempt
+    };
+
+    Schedule schedule = Schedule::None;
+    std::uint64_t baseNodes = 256;
+    double growth = 1.5;
+    unsigned seed = 1;
+
+    bool enabled() const { return schedule != Schedule::None; }
+
+    // False for schedules whose budgets never outgrow the search: a zero
+    // baseNodes, or a geometric growth of 1 or less. On an unsolvable
+    // board their attempts would run out of budget forever. Engines
+    // refuse such a policy in setRestartPolicy.
+    bool valid() const {
+        if (!enabled()) return true;
+        return baseNodes > 0 && (schedule != Schedule::Geometric || growth > 1.0);
+    }
+
+    // Node budget of the attempt-th attempt, counting from 0
+    std::uint64_t budget(int attempt) const;
+
+    // attempt + 1-th term of the Luby sequence
+    static std::uint64_t luby(int attempt);
+
+    // What an attempt ended in
+    enum class Outcome { Solved, Exhausted, OutOfBudget };
+
+    // Calls attempt(budget, seed) until it returns Solved or Exhausted (no
+    // solution, or cancelled). With the schedule None there is a single
+    // attempt with budget 0, meaning unlimited. restarts receives how many
+    // attempts ran out of budget.
+    template <typename Attempt>
+    bool run(Attempt&& attempt, int& restarts) const;
+};
+
+// Names used on the command line: none, luby, geometric
+bool parseRestartSchedule(const std::string& name, RestartPolicy::Schedule& schedule);
+
+template <typename Attempt>
+bool RestartPolicy::run(Attempt&& attempt, int& restarts) const {
+    restarts = 0;
+    if (!enabled()) return attempt(std::uint64_t(0), seed) == Outcome::Solved;
+    for (int i = 0;; ++i) {
+        Outcome outcome = attempt(budget(i), seed + static_cast<unsigned>(i));
+        if (outcome != Outcome::OutOfBudget) return outcome == Outcome::Solved;
+        ++restarts;
+    }
+}
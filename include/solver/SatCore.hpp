@@ -0,0 +1,106 @@
+//include/solver/SatCore.hpp
+#pragma once
+
+#include "CancellationToken.hpp"
+#include <cstdint>
+#include <vector>
+
+// Conflict-driven clause learning over a CNF formula: two watched literals
+// per clause, VSIDS branching with phase saving, first-UIP learning with
+// clause minimization, Luby restarts and activity-based deletion of learnt
+// clauses. Literal 2 * v is variable v, 2 * v + 1 its negation.
+class SatCore {
+public:
+    using Lit = int;
+    static Lit positive(int var) { return 2 * var; }
+    static Lit negative(int var) { return 2 * var + 1; }
+
+    enum class Result { Satisfiable, Unsatisfiable, Unknown };
+
+    int newVar();
+
+    // Adds a clause at the top level, undoing the model of a previous
+    // solve() (read it first), so that solving again continues with the
+    // learnt clauses. Returns false once the formula is known to be
+    // unsatisfiable (e.g. an empty clause).
+    bool addClause(std::vector<Lit> lits);
+
+    // Unknown only if stop was cancelled before an answer was found
+    Result solve(const CancellationToken* stop = nullptr);
+
+    // Model after a Satisfiable result
+    bool getValue(int var) const { return assigns[var] == 1; }
+
+    int getNumVars() const { return static_cast<int>(assigns.size()); }
+    std::size_t getNumClauses() const { return numOriginal; }
+    std::uint64_t getConflicts() const { return conflicts; }
+    std::uint64_t getDecisions() const { return decisions; }
+    std::uint64_t getPropagations() const { return propagations; }
+
+private:
+    struct Clause {
+        std::vector<Lit> lits;   // lits[0], lits[1] are watched
+        float activity = 0.0f;
+        bool learnt = false;
+        bool deleted = false;
+    };
+    struct Watcher {
+        int clause;
+        Lit blocker;             // clause is satisfied if this one is true
+    };
+
+    bool ok = true;
+    std::vector<Clause> clauses;
+    std::vector<std::vector<Watcher>> watches;   // per literal
+    std::size_t numOriginal = 0;
+    std::size_t numLearnts = 0;
+    double maxLearnts = 0.0;
+
+    // Assignment
+    std::vector<std::int8_t> assigns;   // -1 unassigned, 0 false, 1 true
+    std::vector<std::int8_t> polarity;  // last value, reused on decisions
+    std::vector<int> level;
+    std::vector<int> reason;            // implying clause, -1 for decisions
+    std::vector<Lit> trail;
+    std::vector<int> trailLim;          // trail size at each decision
+    std::size_t qhead = 0;
+
+    // VSIDS: max-heap of variables by activity
+    std::vector<double> activity;
+    std::vector<int> heap;
+    std::vector<int> heapIndex;         // -1 when not in the heap
+    double varInc = 1.0;
+    double claInc = 1.0;
+
+    std::vector<std::int8_t> seen;
+    std::vector<Lit> learnt;
+    std::vector<Lit> toClear;
+
+    std::uint64_t conflicts = 0;
+    std::uint64_t decisions = 0;
+    std::uint64_t propagations = 0;
+
+    int litValue(Lit l) const {
+        int a = assigns[l >> 1];
+        return a < 0 ? -1 : a ^ (l & 1);
+    }
+    int decisionLevel() const { return static_cast<int>(trailLim.size()); }
+
+    void enqueue(Lit l, int from);
+    int propagate();
+    void analyze(int conflict, int& backtrackLevel);
+    bool redundant(Lit l) const;
+    void cancelUntil(int target);
+    Lit pickBranchLit();
+    Result search(std::uint64_t conflictBudget, const CancellationToken* stop);
+    int attachClause(std::vector<Lit> lits, bool isLearnt);
+    void reduceLearnts();
+
+    void bumpVar(int var);
+    void bumpClause(Clause& clause);
+
+    void heapInsert(int var);
+    int heapPop();
+    void heapUp(int pos);
+    void heapDown(int pos);
+};
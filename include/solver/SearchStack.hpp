@@ -0,0 +1,145 @@
+//include/solver/SearchStack.hpp
+#pragma once
+
+#include "core/Sudoku.hpp"
+#include "ValueOrder.hpp"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace tf { class Executor; }
+
+// Depth-first fill of the empty cells in row-major order on an explicit
+// stack preallocated with one frame per empty cell instead of recursion.
+// A frame holds the values of its cell not tried yet, so the stack can be
+// inspected and its untried values split off for another worker. Values
+// are tried smallest first unless a ValueOrderer says otherwise; a branch
+// split off is ordered again by the stack that runs it.
+class SearchStack {
+public:
+    // Part of the tree handed to another worker: board has the cells
+    // before depth filled and the rest empty; remaining are the values to
+    // try at depth
+    struct Branch {
+        Sudoku board;
+        int depth = 0;
+        Sudoku::Mask remaining = 0;
+    };
+
+    explicit SearchStack(const Sudoku& sudoku, const ValueOrderer& orderer = ValueOrderer());
+
+    // The whole tree of the board the stack was built for
+    Branch root(const Sudoku& sudoku) const;
+
+    int getNumCells() const { return static_cast<int>(cells.size()); }
+    std::uint64_t getNodeCount() const { return nodeCount; }
+
+    // Searches branch.board in place. onLeaf(board) sees each completed
+    // board and returns true to end the search, which leaves that board
+    // in place; otherwise the board is restored once the branch is done.
+    // poll() runs every pollInterval nodes and returns true to give up.
+    // Returns true only when onLeaf ended the search.
+    template <typename Leaf, typename Poll>
+    bool run(Branch& branch, Leaf&& onLeaf, Poll&& poll);
+
+    // Moves the untried values of the shallowest frame that has any into
+    // stolen, for a run that is in progress on board. False if there is
+    // nothing left to give away.
+    bool split(const Sudoku& board, Branch& stolen);
+
+    static constexpr unsigned pollInterval = 64;
+
+private:
+    std::vector<int> cells;                // empty cells, row * size + col
+    std::vector<Sudoku::Mask> frames;      // untried values per depth
+    int size;
+    int base = 0;                          // depth of the running branch
+    int top = -1;                          // deepest live frame
+    std::uint64_t nodeCount = 0;
+
+    // Non-ascending orders: each depth sorts the values of its frame into
+    // its own size-long slice of orderedValues when it is entered, and
+    // cursor skips the ones tried or split off since. Frequency ranks by
+    // givenCount, LeastConstraining counts the open peers with the value.
+    ValueOrderer orderer;
+    std::vector<int> orderedValues;
+    std::vector<int> cursor;
+    std::vector<int> givenCount;
+    std::vector<int> peers;
+    int numPeers = 0;
+    void orderFrame(const Sudoku& board, int depth);
+    int nextOrdered(int depth, Sudoku::Mask untried) {
+        const int* values = &orderedValues[static_cast<std::size_t>(depth) * size];
+        while (!(untried & (Sudoku::Mask(1) << (values[cursor[depth]] - 1)))) ++cursor[depth];
+        return values[cursor[depth]++];
+    }
+};
+
+template <typename Leaf, typename Poll>
+bool SearchStack::run(Branch& branch, Leaf&& onLeaf, Poll&& poll) {
+    Sudoku& board = branch.board;
+    const int count = static_cast<int>(cells.size());
+    if (branch.depth == count) return onLeaf(board);
+    const bool ordered = orderer.getOrder() != ValueOrder::Ascending;
+
+    base = top = branch.depth;
+    frames[top] = branch.remaining;
+    if (ordered) orderFrame(board, top);
+    while (top >= base) {
+        const int cell = cells[top];
+        const int row = cell / size, col = cell % size;
+        if (board.getValue(row, col) != 0) board.setValue(row, col, 0);
+
+        const Sudoku::Mask m = frames[top];
+        if (m == 0) {
+            --top;
+            continue;
+        }
+        if (ordered) {
+            const int val = nextOrdered(top, m);
+            frames[top] = m & ~(Sudoku::Mask(1) << (val - 1));
+            board.setValue(row, col, val);
+        } else {
+            frames[top] = m & (m - 1);
+            board.setValue(row, col, __builtin_ctzll(m) + 1);
+        }
+
+        if (++nodeCount % pollInterval == 0 && poll()) {
+            top = -1;
+            return false;
+        }
+        if (top + 1 == count) {
+            if (onLeaf(board)) {
+                top = -1;
+                return true;
+            }
+            continue;
+        }
+        ++top;
+        frames[top] = board.getCandidates(cells[top] / size, cells[top] % size);
+        if (ordered) orderFrame(board, top);
+    }
+    top = -1;
+    return false;
+}
+
+// Runs the tree of sudoku on every worker of executor. Workers take
+// branches from a shared queue; while one waits for work, busy workers
+// split their stacks into it. onLeaf runs concurrently on the workers
+// and returns true to end the search everywhere; stop is polled as in
+// SearchStack::run.
+void parallelStackSearch(tf::Executor& executor, const Sudoku& sudoku,
+                         const std::function<bool(const Sudoku&)>& onLeaf,
+                         const std::function<bool()>& stop,
+                         const ValueOrderer& orderer = ValueOrderer());
+
+// Fills sudoku with the first solution any worker finds; false if there is
+// none or stop gave up first
+bool parallelStackSolve(tf::Executor& executor, Sudoku& sudoku, const std::function<bool()>& stop,
+                        const ValueOrderer& orderer = ValueOrderer());
+
+// Solutions of sudoku, counting no further than limit: parallelStackSearch
+// with one counter shared by all workers, which stop once it reaches limit
+std::uint64_t parallelStackCount(tf::Executor& executor, const Sudoku& sudoku, std::uint64_t limit,
+                                 const std::function<bool()>& stop,
+                                 const ValueOrderer& orderer = ValueOrderer());
@@ -0,0 +1,64 @@
+//include/solver/SelectionModel.hpp
+#pragma once
+
+#include "core/Sudoku.hpp"
+#include "ConstraintPropagator.hpp"
+#include <array>
+#include <string>
+#include <vector>
+
+// Cheap description of a puzzle, taken after one propagation pass
+struct PuzzleFeatures {
+    static constexpr int kCount = 8;
+
+    int size = 0;
+    double givensDensity = 0.0;   // givens / cells
+    int forcedCells = 0;          // cells filled by propagation
+    // Open cells after propagation by number of candidates left:
+    // 2, 3-4, 5-8 and 9 or more
+    std::array<int, 4> candidateHistogram{};
+    bool consistent = true;
+    bool solvedByPropagation = false;
+
+    // Regression inputs: bias, ln(size), givens density, forced fraction
+    // and the histogram as fractions of all cells
+    std::array<double, kCount> vector() const;
+
+    // Propagates sudoku into reduced and describes the result
+    static PuzzleFeatures extract(const Sudoku& sudoku, ConstraintPropagator& propagator,
+                                  Sudoku& reduced);
+};
+
+// Per engine configuration, a ridge regression of ln(solve time in ms) on
+// PuzzleFeatures::vector(), fitted on BenchmarkManager CSV results. The
+// selection is the configuration with the lowest predicted time.
+class SelectionModel {
+public:
+    struct Candidate {
+        std::string engine;   // name understood by AdaptiveSolver::makeEngine
+        int numThreads = 1;
+        int maxSize = 0;      // largest board size in the training data
+        std::array<double, PuzzleFeatures::kCount> weights{};
+
+        double predictLogMs(const std::array<double, PuzzleFeatures::kCount>& x) const;
+    };
+
+    // Fits a model on a BenchmarkManager CSV. Puzzle paths are loaded
+    // relative to the working directory. Rows of unknown engines, failed
+    // solves and batch runs are skipped; a "Propagation+X" row stands in
+    // for X, since the adaptive solver propagates before handing over.
+    static SelectionModel fitFromCSV(const std::string& csvPath);
+
+    bool load(const std::string& path);
+    bool save(const std::string& path) const;
+
+    // Fastest predicted candidate using at most maxThreads threads and
+    // trained on boards at least this large, nullptr if there is none
+    const Candidate* select(const PuzzleFeatures& features, int maxThreads) const;
+
+    const std::vector<Candidate>& getCandidates() const { return candidates; }
+    bool empty() const { return candidates.empty(); }
+
+private:
+    std::vector<Candidate> candidates;
+};
@@ -0,0 +1,59 @@
+//include/solver/SolutionStream.hpp
+#pragma once
+
+#include "SolverBase.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+// Bounded hand-over of solutions from search workers to one consumer
+// thread. Workers fill a private Writer buffer and pass it on a batch at a
+// time; once maxBatches are waiting they block until the consumer catches
+// up, so memory stays flat however many solutions there are.
+class SolutionStream {
+public:
+    explicit SolutionStream(std::size_t batchSize = 64, std::size_t maxBatches = 16);
+
+    SolutionStream(const SolutionStream&) = delete;
+    SolutionStream& operator=(const SolutionStream&) = delete;
+
+    // Per-worker buffer, flushed when full and on destruction
+    class Writer {
+    public:
+        explicit Writer(SolutionStream& stream);
+        ~Writer();
+
+        // False once the consumer has stopped; the producer should give up
+        bool push(const Sudoku& solution);
+        bool flush();
+
+    private:
+        SolutionStream& stream;
+        std::vector<Sudoku> buffer;
+    };
+
+    // No more batches will come; consume returns once the queue is empty
+    void close();
+
+    // Delivers solutions to onSolution on the calling thread until the
+    // stream is closed and drained or onSolution returns false. Returns
+    // the number delivered.
+    std::uint64_t consume(const SolutionCallback& onSolution);
+
+    // Raised when the consumer stops early, for producers to poll
+    const std::atomic<bool>& stopFlag() const { return stopped; }
+
+private:
+    bool pushBatch(std::vector<Sudoku>&& batch);
+
+    const std::size_t batchSize;
+    const std::size_t maxBatches;
+
+    std::mutex mutex;
+    std::condition_variable notEmpty, notFull;
+    std::deque<std::vector<Sudoku>> batches;
+    bool closed = false;
+    std::atomic<bool> stopped{false};
+};
@@ -2,18 +2,132 @@
 #pragma once
 
 #include "core/Sudoku.hpp"
+#include "CancellationToken.hpp"
+#include "ValueOrder.hpp"
+#include "RestartPolicy.hpp"
 #include <vector>
-#include <memory> 
+#include <memory>
+#include <cstdint>
+#include <functional>
+
+class SolverSession;
+
+// Receives each solution of an enumeration; returning false stops it
+using SolutionCallback = std::function<bool(const Sudoku& solution)>;
+
+struct BatchOptions {
+    int numThreads = 2;
+    // Boards at least this large are solved one at a time with the
+    // solver's own (intra-puzzle) parallelism instead of being spread
+    // across the batch workers, if it has any (hasIntraPuzzleParallelism)
+    int intraPuzzleMinSize = 25;
+    // Worker pool for the batch; the process-wide one for numThreads if null
+    std::shared_ptr<SolverSession> session;
+};
+
+struct BatchResult {
+    std::size_t total = 0;
+    std::size_t solved = 0;
+    std::vector<std::uint8_t> success;   // per board
+    double elapsedMs = 0.0;
+    double puzzlesPerSecond = 0.0;
+};
 
 class SolverBase {
 public:
     virtual bool solve(Sudoku& sudoku) = 0;
 
-    // TODO solveAll
+    // Streams every solution to onSolution on the calling thread and
+    // returns how many were delivered. Engines without an enumeration
+    // deliver none.
+    virtual std::uint64_t enumerate(const Sudoku&, const SolutionCallback&) {
+        return 0;
+    }
+
+    // Collects the solutions of enumerate; prefer enumerate on puzzles
+    // with many solutions
     virtual bool solveAll(Sudoku& sudoku, std::vector<Sudoku>& allSolutions) {
-        return false;
+        return enumerate(sudoku, [&](const Sudoku& solution) {
+            allSolutions.push_back(solution);
+            return true;
+        }) > 0;
     }
     virtual std::unique_ptr<SolverBase> clone() const = 0;
 
+    // Number of solutions, counting no further than limit, or
+    // CountUnsupported if the engine cannot tell. The default goes through
+    // enumerate, or solve for limit 1; a solvable board that enumerate
+    // delivers nothing for is CountUnsupported. Engines override it with a
+    // search that stops at the limit without materializing boards.
+    static constexpr std::uint64_t CountUnsupported = ~std::uint64_t(0);
+    virtual std::uint64_t countSolutions(const Sudoku& sudoku, std::uint64_t limit);
+    bool hasUniqueSolution(const Sudoku& sudoku) {
+        return countSolutions(sudoku, 2) == 1;
+    }
+
+    // Solves count independent boards in place, whole puzzles per worker
+    BatchResult solveBatch(Sudoku* boards, std::size_t count, const BatchOptions& options = {});
+    BatchResult solveBatch(std::vector<Sudoku>& boards, const BatchOptions& options = {}) {
+        return solveBatch(boards.data(), boards.size(), options);
+    }
+
+    // Search loops poll this token and give up without a solution once it
+    // is cancelled; the board may then be left partly filled. Clones
+    // share the token.
+    virtual void setCancellationToken(std::shared_ptr<CancellationToken> token) {
+        cancelToken = std::move(token);
+    }
+    const std::shared_ptr<CancellationToken>& getCancellationToken() const { return cancelToken; }
+
+    // Order in which the search tries the values of a branching cell;
+    // seed drives ValueOrder::Random. Returns false, leaving the solver
+    // as it was, if the engine has no use for that order.
+    virtual bool setValueOrder(ValueOrder order, unsigned = 1) {
+        return order == ValueOrder::Ascending;
+    }
+
+    // Search nodes (placements or decisions) of the last run, 0 for
+    // engines that do not count them
+    virtual std::uint64_t getNodeCount() const { return 0; }
+
+    // Restarts for solve (enumerate and countSolutions always search
+    // once). Returns false, leaving the solver as it was, if the engine
+    // cannot restart.
+    virtual bool setRestartPolicy(const RestartPolicy& policy) {
+        return !policy.enabled();
+    }
+    // Attempts of the last solve that ran out of budget
+    virtual int getRestartCount() const { return 0; }
+
+    // True if solve spreads one puzzle over several threads; solveBatch
+    // only keeps large boards on the calling thread for such engines
+    virtual bool hasIntraPuzzleParallelism() const { return false; }
+
     virtual ~SolverBase() = default;
+
+protected:
+    // Solves count boards of a batch in place and sets solved[i] for each;
+    // one solveBatch worker calls it with up to batchGrain() boards at a
+    // time, on a clone() of its own. The default solves them one by one;
+    // engines that gain from seeing many boards at once override all three,
+    // and parallel engines override the chunk to solve single-threaded,
+    // since the batch already keeps every worker busy with whole puzzles.
+    // Chunks shrink from batchGrain() towards batchMinGrain() when a batch
+    // is too small to give every worker a full one.
+    virtual void solveBatchChunk(Sudoku* const* boards, std::size_t count, std::uint8_t* solved);
+    virtual std::size_t batchGrain() const { return 1; }
+    virtual std::size_t batchMinGrain() const { return 1; }
+    // For wrappers, which hand the chunk on to the solver they wrap
+    static void solveBatchChunk(SolverBase& solver, Sudoku* const* boards, std::size_t count,
+                                std::uint8_t* solved) {
+        solver.solveBatchChunk(boards, count, solved);
+    }
+    static std::size_t batchGrain(const SolverBase& solver) { return solver.batchGrain(); }
+    static std::size_t batchMinGrain(const SolverBase& solver) { return solver.batchMinGrain(); }
+
+    bool isCancelled() const { return cancelToken && cancelToken->isCancelled(); }
+    const CancellationToken* cancellationToken() const { return cancelToken.get(); }
+
+private:
+    std::shared_ptr<CancellationToken> cancelToken;
 };
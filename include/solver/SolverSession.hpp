@@ -0,0 +1,29 @@
+//include/solver/SolverSession.hpp
+#pragma once
+
+#include <memory>
+#include <taskflow/taskflow.hpp>
+
+// Long-lived worker pool shared by the parallel solvers, so that threads
+// are created once instead of on every solve call. Pass one session to
+// several solvers (or rely on shared()) and reuse it across puzzles.
+//
+// A solve must not be started from inside one of the session's own
+// workers: it blocks on the pool it is waiting for.
+class SolverSession {
+public:
+    explicit SolverSession(int numThreads);
+
+    SolverSession(const SolverSession&) = delete;
+    SolverSession& operator=(const SolverSession&) = delete;
+
+    tf::Executor& getExecutor() { return executor; }
+    int getNumThreads() const { return numThreads; }
+
+    // Process-wide session for a thread count, created on first use
+    static std::shared_ptr<SolverSession> shared(int numThreads);
+
+private:
+    int numThreads;
+    tf::Executor executor;
+};
@@ -0,0 +1,52 @@
+//include/solver/ValueOrder.hpp
+#pragma once
+
+#include "core/Sudoku.hpp"
+#include <algorithm>
+#include <random>
+#include <string>
+
+// Order in which a search tries the values of the cell it branches on
+// (for DLX, the rows of the column it branches on)
+enum class ValueOrder {
+    Ascending,          // 1..N
+    LeastConstraining,  // values that strike the fewest peer candidates first
+    Frequency,          // values placed most often among the givens first
+    Random              // shuffled by a seeded generator
+};
+
+// Names used on the command line and in benchmark results:
+// ascending, lcv, frequency, random
+bool parseValueOrder(const std::string& name, ValueOrder& order);
+const char* valueOrderName(ValueOrder order);
+
+// Puts the values of a candidate mask in the order of a strategy. For
+// LeastConstraining and Frequency, score(val) ranks them, smallest first,
+// ties in ascending order.
+class ValueOrderer {
+public:
+    explicit ValueOrderer(ValueOrder order = ValueOrder::Ascending, unsigned seed = 1)
+        : order(order), rng(seed) {}
+
+    ValueOrder getOrder() const { return order; }
+
+    // Writes the values of mask to values and returns how many there are
+    template <typename Score>
+    int sort(Sudoku::Mask mask, int* values, Score&& score) {
+        int count = 0;
+        for (; mask; mask &= mask - 1) values[count++] = __builtin_ctzll(mask) + 1;
+        if (order == ValueOrder::Random) {
+            std::shuffle(values, values + count, rng);
+        } else if (order != ValueOrder::Ascending) {
+            int scores[Sudoku::MaxSize + 1];
+            for (int i = 0; i < count; ++i) scores[values[i]] = score(values[i]);
+            std::stable_sort(values, values + count,
+                             [&](int a, int b) { return scores[a] < scores[b]; });
+        }
+        return count;
+    }
+
+private:
+    ValueOrder order;
+    std::minstd_rand rng;
+};
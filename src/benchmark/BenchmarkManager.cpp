@@ -1,6 +1,8 @@
 //src/benchmark/BenchmarkManager.cpp
 #include "benchmark/BenchmarkManager.hpp"
+#include "benchmark/AllocationCounter.hpp"
 #include "io/FileIO.hpp"
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 #include <fstream>
@@ -8,8 +10,24 @@
 BenchmarkManager::BenchmarkManager(const std::vector<std::string>& puzzlePaths)
     : puzzlePaths(puzzlePaths) {}
 
-void BenchmarkManager::addSolver(const std::string& name, std::unique_ptr<SolverBase> solver) {
-    solvers.emplace_back(name, std::move(solver));
+void BenchmarkManager::addSolver(const std::string& name, std::unique_ptr<SolverBase> solver, int numThreads) {
+    solvers.push_back({name, std::move(solver), numThreads, ValueOrder::Ascending});
+    applyValueOrder(solvers.back());
+}
+
+void BenchmarkManager::setValueOrder(ValueOrder order, unsigned seed) {
+    valueOrder = order;
+    valueOrderSeed = seed;
+    for (auto& entry : solvers) applyValueOrder(entry);
+}
+
+void BenchmarkManager::applyValueOrder(SolverEntry& entry) {
+    if (entry.solver->setValueOrder(valueOrder, valueOrderSeed)) {
+        entry.valueOrder = valueOrder;
+    } else {
+        entry.solver->setValueOrder(ValueOrder::Ascending);
+        entry.valueOrder = ValueOrder::Ascending;
+    }
 }
 
 void BenchmarkManager::runBenchmarks() {
@@ -18,6 +36,67 @@ void BenchmarkManager::runBenchmarks() {
     }
 }
 
+void BenchmarkManager::runBatchBenchmarks(int copies, const BatchOptions& options) {
+    std::vector<Sudoku> puzzles;
+    for (const auto& puzzlePath : puzzlePaths) {
+        Sudoku puzzle;
+        if (!FileIO::loadSudokuFromFile(puzzle, puzzlePath)) {
+            std::cerr << "Failed to load puzzle from file: " << puzzlePath << std::endl;
+            continue;
+        }
+        puzzles.push_back(puzzle);
+    }
+    if (puzzles.empty()) return;
+
+    for (auto& [solverName, solver, numThreads, order] : solvers) {
+        std::vector<Sudoku> batch;
+        batch.reserve(puzzles.size() * copies);
+        for (int i = 0; i < copies; ++i)
+            batch.insert(batch.end(), puzzles.begin(), puzzles.end());
+
+        BatchResult batchResult = solver->solveBatch(batch, options);
+        std::string batchName = "batch x" + std::to_string(batch.size());
+        results.push_back({solverName, numThreads, batchName, batchResult.elapsedMs,
+                           batchResult.solved == batchResult.total, valueOrderName(order)});
+        std::cout << solverName << " solved " << batchResult.solved << "/" << batchResult.total
+                  << " puzzles in " << batchResult.elapsedMs << " ms ("
+                  << batchResult.puzzlesPerSecond << " puzzles/s)" << std::endl;
+    }
+}
+
+void BenchmarkManager::runAllocationBenchmarks(int rounds) {
+    for (const auto& puzzlePath : puzzlePaths) {
+        Sudoku puzzle;
+        if (!FileIO::loadSudokuFromFile(puzzle, puzzlePath)) {
+            std::cerr << "Failed to load puzzle from file: " << puzzlePath << std::endl;
+            continue;
+        }
+
+        for (auto& [solverName, solver, numThreads, order] : solvers) {
+            Sudoku sudoku = puzzle;
+            bool success = solver->solve(sudoku);
+
+            std::uint64_t most = 0;
+            double totalMs = 0.0;
+            for (int i = 0; i < rounds; ++i) {
+                sudoku = puzzle;
+                const std::uint64_t before = AllocationCounter::count();
+                auto start = std::chrono::high_resolution_clock::now();
+                success = solver->solve(sudoku) && success;
+                auto end = std::chrono::high_resolution_clock::now();
+                most = std::max(most, AllocationCounter::count() - before);
+                totalMs += std::chrono::duration<double, std::milli>(end - start).count();
+            }
+
+            const double timeMs = rounds > 0 ? totalMs / rounds : 0.0;
+            results.push_back({solverName, numThreads, puzzlePath, timeMs, success, valueOrderName(order),
+                               solver->getNodeCount(), most});
+            std::cout << solverName << " solved " << puzzlePath << " in " << timeMs << " ms with "
+                      << most << " allocations" << (success ? " ✔" : " ✘") << std::endl;
+        }
+    }
+}
+
 void BenchmarkManager::benchmarkSinglePuzzle(const std::string& puzzlePath) {
     Sudoku puzzle;
     if (!FileIO::loadSudokuFromFile(puzzle, puzzlePath)) {
@@ -25,23 +104,26 @@ void BenchmarkManager::benchmarkSinglePuzzle(const std::string& puzzlePath) {
         return;
     }
 
-    for (auto& [solverName, solver] : solvers) {
+    for (auto& [solverName, solver, numThreads, order] : solvers) {
         Sudoku sudoku = puzzle; // copy
         auto start = std::chrono::high_resolution_clock::now();
         bool success = solver->solve(sudoku);
         auto end = std::chrono::high_resolution_clock::now();
         double timeMs = std::chrono::duration<double, std::milli>(end - start).count();
 
-        results.push_back({solverName, puzzlePath, timeMs, success});
-        std::cout << solverName << " solved " << puzzlePath << " in " << timeMs << " ms"
-                  << (success ? " ✔" : " ✘") << std::endl;
+        std::uint64_t nodes = solver->getNodeCount();
+        results.push_back({solverName, numThreads, puzzlePath, timeMs, success, valueOrderName(order), nodes});
+        std::cout << solverName << " solved " << puzzlePath << " in " << timeMs << " ms";
+        if (nodes > 0) std::cout << ", " << nodes << " nodes";
+        std::cout << (success ? " ✔" : " ✘") << std::endl;
     }
 }
 
 void BenchmarkManager::exportResultsCSV(const std::string& path) const {
     std::ofstream out(path);
-    out << "Solver,Puzzle,TimeMs,Success\n";
+    out << "Solver,Threads,Puzzle,TimeMs,Success,ValueOrder,Nodes,Allocations\n";
     for (const auto& r : results) {
-        out << r.solverName << "," << r.puzzleName << "," << r.timeMs << "," << (r.success ? "true" : "false") << "\n";
+        out << r.solverName << "," << r.numThreads << "," << r.puzzleName << "," << r.timeMs << "," << (r.success ? "true" : "false")
+            << "," << r.valueOrder << "," << r.nodeCount << "," << r.allocations << "\n";
     }
 }
@@ -0,0 +1,99 @@
+//src/benchmark/DLXMicrobenchmark.cpp
+// Microbenchmark of the DancingLinks engine on its own: matrix size and
+// memory, build time, cover + uncover cost per column and full solve time
+// for each bundled board. Built as the dlx_microbenchmark target.
+
+#include "solver/DLXSolver.hpp"
+#include "solver/DancingLinks.hpp"
+#include "io/FileIO.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedNs(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+// Best of rounds runs of f, in nanoseconds
+template <typename F>
+double bestOf(int rounds, F&& f) {
+    double best = 0.0;
+    for (int i = 0; i < rounds; ++i) {
+        auto start = Clock::now();
+        f();
+        double ns = elapsedNs(start);
+        if (i == 0 || ns < best) best = ns;
+    }
+    return best;
+}
+
+void benchmarkPuzzle(const std::string& path, int rounds) {
+    Sudoku puzzle;
+    if (!FileIO::loadSudokuFromFile(puzzle, path)) {
+        std::cerr << "Failed to load puzzle from file: " << path << std::endl;
+        return;
+    }
+    const int size = puzzle.getSize();
+
+    DancingLinks matrix;
+    double buildNs = bestOf(rounds, [&] { DLXSolver::buildExactCoverMatrix(matrix, puzzle); });
+
+    // Selecting a row covers each of its columns and unselecting it
+    // uncovers them, so the pair costs one cover + uncover per column
+    std::vector<int> rows;
+    for (int rowID = 0; rowID < size * size * size; ++rowID)
+        if (matrix.getRowNode(rowID) >= 0 && matrix.selectRow(rowID)) {
+            matrix.unselectRow(rowID);
+            rows.push_back(rowID);
+        }
+    double coverNs = 0.0;
+    if (!rows.empty()) {
+        coverNs = bestOf(rounds, [&] {
+            for (int rowID : rows) {
+                matrix.selectRow(rowID);
+                matrix.unselectRow(rowID);
+            }
+        }) / (4.0 * rows.size());
+    }
+
+    DLXSolver solver(1);
+    bool solved = true;
+    double solveNs = bestOf(rounds, [&] {
+        Sudoku board = puzzle;
+        solved = solver.solve(board) && solved;
+    });
+
+    std::cout << path << ": " << matrix.getNumColumns() << " columns, "
+              << matrix.getNumNodes() << " nodes, "
+              << matrix.getMemoryBytes() / 1024.0 << " KiB, build "
+              << buildNs / 1e3 << " us, cover+uncover " << coverNs << " ns/column, solve "
+              << solveNs / 1e6 << " ms" << (solved ? "" : " (unsolved)") << std::endl;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> testFiles = {
+        "../Test_Cases/9x9_easy.txt",
+        "../Test_Cases/9x9_medium.txt",
+        "../Test_Cases/9x9_hard.txt",
+        "../Test_Cases/16x16_easy.txt",
+        "../Test_Cases/16x16_medium.txt",
+        "../Test_Cases/16x16_hard.txt",
+        "../Test_Cases/25x25_easy.txt",
+        "../Test_Cases/25x25_medium.txt",
+        "../Test_Cases/25x25_hard.txt"
+    };
+    // Puzzle files on the command line replace the bundled ones
+    if (argc > 1) testFiles.assign(argv + 1, argv + argc);
+
+    const int rounds = 20;
+    for (const auto& path : testFiles) benchmarkPuzzle(path, rounds);
+    return 0;
+}
@@ -0,0 +1,105 @@
+//src/benchmark/SearchStackBenchmark.cpp
+// Row-major brute force on an explicit SearchStack against the recursive
+// std::function search it replaced, single-threaded, plus the work-splitting
+// parallelStackSearch on every core. Built as the search_stack_benchmark
+// target.
+
+#include "solver/SearchStack.hpp"
+#include "solver/SolverSession.hpp"
+#include "io/FileIO.hpp"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// The former BruteForceSolver: the same tree as SearchStack (empty cells
+// in row-major order, valid values ascending), walked by a recursive
+// std::function. Returns the number of complete boards up to limit.
+std::uint64_t recursiveSearch(Sudoku board, std::uint64_t limit) {
+    auto emptyCells = board.getEmptyCells();
+    std::uint64_t found = 0;
+
+    std::function<bool(size_t)> dfs = [&](size_t index) {
+        if (index == emptyCells.size()) return ++found >= limit;
+
+        auto [row, col] = emptyCells[index];
+        for (int val = 1; val <= board.getSize(); ++val) {
+            if (board.isValid(row, col, val)) {
+                board.setValue(row, col, val);
+                if (dfs(index + 1)) return true;
+                board.setValue(row, col, 0);
+            }
+        }
+        return false;
+    };
+
+    dfs(0);
+    return found;
+}
+
+std::uint64_t stackSearch(const Sudoku& sudoku, std::uint64_t limit) {
+    SearchStack stack(sudoku);
+    SearchStack::Branch branch = stack.root(sudoku);
+    std::uint64_t found = 0;
+    stack.run(branch, [&](const Sudoku&) { return ++found >= limit; }, []() { return false; });
+    return found;
+}
+
+void report(const std::string& name, const std::string& task, std::uint64_t found, double ms) {
+    std::cout << "  " << name << " " << task << ": " << found << " in " << ms << " ms" << std::endl;
+}
+
+void benchmarkPuzzle(const std::string& name, const Sudoku& puzzle, std::uint64_t limit,
+                     tf::Executor& executor) {
+    const std::string task = limit == 1 ? "solve" : "count";
+    std::cout << name << ":" << std::endl;
+
+    auto start = Clock::now();
+    std::uint64_t found = recursiveSearch(puzzle, limit);
+    report("recursive", task, found, elapsedMs(start));
+
+    start = Clock::now();
+    found = stackSearch(puzzle, limit);
+    report("SearchStack", task, found, elapsedMs(start));
+
+    start = Clock::now();
+    found = parallelStackCount(executor, puzzle, limit, []() { return false; });
+    report("parallelStackSearch x" + std::to_string(executor.num_workers()), task, found, elapsedMs(start));
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    const int numThreads = argc > 1 ? std::stoi(argv[1]) : static_cast<int>(std::thread::hardware_concurrency());
+    auto session = std::make_shared<SolverSession>(numThreads > 0 ? numThreads : 1);
+
+    Sudoku hard;
+    if (!FileIO::loadSudokuFromFile(hard, "../Test_Cases/9x9_hard.txt")) {
+        std::cerr << "Failed to load puzzle from file: ../Test_Cases/9x9_hard.txt" << std::endl;
+        return 1;
+    }
+    benchmarkPuzzle("9x9_hard", hard, 1, session->getExecutor());
+
+    // 9x9_easy with its first three rows cleared has 20076 solutions
+    Sudoku open;
+    if (!FileIO::loadSudokuFromFile(open, "../Test_Cases/9x9_easy.txt")) {
+        std::cerr << "Failed to load puzzle from file: ../Test_Cases/9x9_easy.txt" << std::endl;
+        return 1;
+    }
+    for (int row = 0; row < 3; ++row)
+        for (int col = 0; col < 9; ++col) open.setValue(row, col, 0);
+    benchmarkPuzzle("9x9_easy, rows 1-3 cleared", open, UINT64_MAX, session->getExecutor());
+    return 0;
+}
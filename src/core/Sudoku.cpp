@@ -5,8 +5,37 @@
 #include <cmath>
 #include <iostream>
 
-Sudoku::Sudoku(int size) : size(size), board(size, std::vector<int>(size, 0)) {
-    boxSize = static_cast<int>(std::sqrt(size));
+namespace {
+const char Alphabet[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz@#$";
+}
+
+char Sudoku::valueSymbol(int val) {
+    return val >= 0 && val <= MaxSize ? Alphabet[val] : '?';
+}
+
+int Sudoku::symbolValue(char symbol) {
+    if (symbol == '.') return 0;
+    for (int val = 0; val <= MaxSize; ++val)
+        if (Alphabet[val] == symbol) return val;
+    return -1;
+}
+
+Sudoku::Sudoku(int size) {
+    reset(size);
+}
+
+void Sudoku::reset(int n) {
+    size = n;
+    boxSize = static_cast<int>(std::sqrt(n));
+    filled = 0;
+
+    cells.assign(size * size, 0);
+    rowMask.assign(size, 0);
+    colMask.assign(size, 0);
+    boxMask.assign(size, 0);
+    rowCount.assign(size * size, 0);
+    colCount.assign(size * size, 0);
+    boxCount.assign(size * size, 0);
 }
 
 bool Sudoku::loadFromFile(const std::string& filename) {
@@ -15,94 +44,138 @@ bool Sudoku::loadFromFile(const std::string& filename) {
 
     int n;
     in >> n;           // Read the first line size
-    if (n != size) {   // If the Sudoku object size and file size are different, reconfigure
-        size = n;
-        boxSize = static_cast<int>(std::sqrt(n));
-        board.assign(size, std::vector<int>(size, 0));
-    }
-
-    for (int r = 0; r < size; ++r) {
-        for (int c = 0; c < size; ++c) {
-            int val;
-            in >> val;
-            if (!in) return false;
-            setValue(r, c, val);
+    if (!in || n <= 0 || n > MaxSize) return false;
+    reset(n);          // Always start from an empty board of the file size
+    if (boxSize * boxSize != n) return false;
+
+    // Cells are whitespace-separated numbers (one or two digits) or
+    // symbols; longer tokens such as "53..7.A" hold one symbol per cell
+    int cell = 0;
+    std::string token;
+    while (cell < size * size && in >> token) {
+        bool number = token.size() <= 2 &&
+            token.find_first_not_of("0123456789") == std::string::npos;
+        if (number) {
+            int val = std::stoi(token);
+            if (val > size) return false;
+            setValue(cell / size, cell % size, val);
+            ++cell;
+            continue;
+        }
+        for (char symbol : token) {
+            int val = symbolValue(symbol);
+            if (val < 0 || val > size || cell == size * size) return false;
+            setValue(cell / size, cell % size, val);
+            ++cell;
         }
     }
-    return true;
+    return cell == size * size;
 }
 
-bool Sudoku::isValid(int row, int col, int val) const {
-    for (int c = 0; c < size; ++c)
-        if (c != col && board[row][c] == val)
-            return false;
+void Sudoku::place(int row, int col, int val) {
+    const int box = getBoxIndex(row, col);
+    const int v = val - 1;
+    const Mask bit = Mask(1) << v;
 
-    for (int r = 0; r < size; ++r)
-        if (r != row && board[r][col] == val)
-            return false;
-
-    int startRow = row - row % boxSize;
-    int startCol = col - col % boxSize;
-    for (int r = 0; r < boxSize; ++r)
-        for (int c = 0; c < boxSize; ++c) {
-            int curRow = startRow + r;
-            int curCol = startCol + c;
-            if ((curRow != row || curCol != col) && board[curRow][curCol] == val)
-                return false;
-        }
+    if (rowCount[row * size + v]++ == 0) rowMask[row] |= bit;
+    if (colCount[col * size + v]++ == 0) colMask[col] |= bit;
+    if (boxCount[box * size + v]++ == 0) boxMask[box] |= bit;
+    ++filled;
+}
+
+void Sudoku::remove(int row, int col, int val) {
+    const int box = getBoxIndex(row, col);
+    const int v = val - 1;
+    const Mask bit = Mask(1) << v;
 
-    return true;
+    if (--rowCount[row * size + v] == 0) rowMask[row] &= ~bit;
+    if (--colCount[col * size + v] == 0) colMask[col] &= ~bit;
+    if (--boxCount[box * size + v] == 0) boxMask[box] &= ~bit;
+    --filled;
 }
 
+bool Sudoku::isValid(int row, int col, int val) const {
+    if (val < 1 || val > size) return false;
+
+    // The cell already holds val: it is valid only if it is the sole copy
+    if (cells[row * size + col] == val) {
+        const int v = val - 1;
+        return rowCount[row * size + v] == 1 &&
+               colCount[col * size + v] == 1 &&
+               boxCount[getBoxIndex(row, col) * size + v] == 1;
+    }
+
+    return isRowValid(row, val) && isColValid(col, val) &&
+           isBoxValid(getBoxIndex(row, col), val);
+}
 
 bool Sudoku::isRowValid(int row, int val) const {
-    for (int col = 0; col < size; ++col)
-        if (board[row][col] == val) return false;
-    return true;
+    return !(rowMask[row] & (Mask(1) << (val - 1)));
 }
 
 bool Sudoku::isColValid(int col, int val) const {
-    for (int row = 0; row < size; ++row)
-        if (board[row][col] == val) return false;
-    return true;
+    return !(colMask[col] & (Mask(1) << (val - 1)));
+}
+
+bool Sudoku::isBoxValid(int box, int val) const {
+    return !(boxMask[box] & (Mask(1) << (val - 1)));
+}
+
+Sudoku::Mask Sudoku::getCandidates(int row, int col) const {
+    if (cells[row * size + col] != 0) return 0;
+    return getFullMask() & ~(rowMask[row] | colMask[col] | boxMask[getBoxIndex(row, col)]);
 }
 
-bool Sudoku::isBoxValid(int startRow, int startCol, int val) const {
-    for (int r = 0; r < boxSize; ++r)
-        for (int c = 0; c < boxSize; ++c)
-            if (board[startRow + r][startCol + c] == val)
-                return false;
-    return true;
+Sudoku::Mask Sudoku::getFullMask() const {
+    return size >= static_cast<int>(sizeof(Mask) * 8) ? ~Mask(0) : (Mask(1) << size) - 1;
 }
 
 bool Sudoku::isComplete() const {
-    for (const auto& row : board)
-        for (int val : row)
-            if (val == 0) return false;
-    return true;
+    return filled == size * size;
 }
 
 void Sudoku::setValue(int row, int col, int val) {
-    board[row][col] = val;
+    auto& cell = cells[row * size + col];
+    if (cell == val) return;
+    if (cell != 0) remove(row, col, cell);
+    cell = static_cast<std::uint8_t>(val);
+    if (val != 0) place(row, col, val);
 }
 
 int Sudoku::getValue(int row, int col) const {
-    return board[row][col];
+    return cells[row * size + col];
 }
 
 int Sudoku::getSize() const {
     return size;
 }
 
-const std::vector<std::vector<int>>& Sudoku::getBoard() const {
+int Sudoku::getBoxSize() const {
+    return boxSize;
+}
+
+int Sudoku::getBoxIndex(int row, int col) const {
+    return (row / boxSize) * boxSize + col / boxSize;
+}
+
+const std::vector<std::uint8_t>& Sudoku::getCells() const {
+    return cells;
+}
+
+std::vector<std::vector<int>> Sudoku::getBoard() const {
+    std::vector<std::vector<int>> board(size, std::vector<int>(size));
+    for (int r = 0; r < size; ++r)
+        for (int c = 0; c < size; ++c)
+            board[r][c] = cells[r * size + c];
     return board;
 }
 
 std::vector<std::pair<int, int>> Sudoku::getEmptyCells() const {
     std::vector<std::pair<int, int>> empty;
+    empty.reserve(size * size - filled);
     for (int r = 0; r < size; ++r)
         for (int c = 0; c < size; ++c)
-            if (board[r][c] == 0)
+            if (cells[r * size + c] == 0)
                 empty.emplace_back(r, c);
     return empty;
 }
@@ -117,7 +190,7 @@ void Sudoku::print() const {
         for (int j = 0; j < size; ++j) {
             if (j % boxSize == 0 && j != 0)
                 std::cout << "| ";
-            std::cout << board[i][j] << ' ';
+            std::cout << valueSymbol(getValue(i, j)) << ' ';
         }
         std::cout << "\n";
     }
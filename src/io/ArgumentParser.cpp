@@ -14,6 +14,14 @@ ParsedArgs ArgumentParser::parse(int argc, char* argv[]) {
             args.mode = std::stoi(argv[++i]);
         } else if (arg == "-t" && i + 1 < argc) {
             args.numThreads = std::stoi(argv[++i]);
+        } else if (arg == "-p" && i + 1 < argc) {
+            args.propagation = std::stoi(argv[++i]);
+        } else if (arg == "-s" && i + 1 < argc) {
+            args.modelFile = argv[++i];
+        } else if (arg == "-v" && i + 1 < argc) {
+            args.valueOrder = argv[++i];
+        } else if (arg == "-r" && i + 1 < argc) {
+            args.restarts = argv[++i];
         } else if (arg == "-w") {
             args.writeToFile = true;
         }
@@ -12,12 +12,11 @@ bool writeSolutionToFile(const Sudoku& sudoku, const std::string& filename) {
     std::ofstream out(filename);
     if (!out) return false;
 
-    const auto& board = sudoku.getBoard();
     int size = sudoku.getSize();
 
     for (int r = 0; r < size; ++r) {
         for (int c = 0; c < size; ++c) {
-            out << board[r][c];
+            out << sudoku.getValue(r, c);
             if (c != size - 1) out << ' ';
         }
         out << '\n';
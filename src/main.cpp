@@ -10,6 +10,13 @@
 #include "solver/ParallelBacktrackingSolver.hpp"
 #include "solver/ParallelBruteForceSolver.hpp"
 #include "solver/ParallelDLXSolver.hpp"
+#include "solver/FixedSizeSolver.hpp"
+#include "solver/PropagatingSolver.hpp"
+#include "solver/CDCLSolver.hpp"
+#include "solver/PortfolioSolver.hpp"
+#include "solver/AdaptiveSolver.hpp"
+#include "solver/BitboardSolver.hpp"
+#include "core/FixedSudoku.hpp"
 
 int main(int argc, char* argv[]) {
     // parse instruction
@@ -30,12 +37,36 @@ int main(int argc, char* argv[]) {
     std::cout << "Input Sudoku:\n";
     sudoku.print();
 
+    ValueOrder valueOrder;
+    if (!parseValueOrder(args.valueOrder, valueOrder)) {
+        std::cerr << "Unknown value order: " << args.valueOrder << "\n";
+        return 1;
+    }
+
+    RestartPolicy restartPolicy;
+    if (!parseRestartSchedule(args.restarts, restartPolicy.schedule)) {
+        std::cerr << "Unknown restart schedule: " << args.restarts << "\n";
+        return 1;
+    }
+
     // choose sudoku solver
     std::unique_ptr<SolverBase> solver;
+    PortfolioSolver* portfolio = nullptr;
+    AdaptiveSolver* adaptive = nullptr;
     switch (args.mode) {
-        case 0:
-            solver = std::make_unique<BacktrackingSolver>(args.numThreads);
+        case 0: {
+            // Sizes with a fixed-size kernel get it, as it searches in the
+            // same row-major order; the options it lacks need the runtime one
+            if (Fixed::isSupported(sudoku.getSize()) && args.propagation < 2 &&
+                !restartPolicy.enabled()) {
+                solver = std::make_unique<FixedSizeSolver>(args.numThreads);
+                break;
+            }
+            auto backtracking = std::make_unique<BacktrackingSolver>(args.numThreads);
+            backtracking->setNodePropagation(args.propagation >= 2);
+            solver = std::move(backtracking);
             break;
+        }
         case 1:
             solver = std::make_unique<BruteForceSolver>(args.numThreads);
             break;
@@ -51,12 +82,93 @@ int main(int argc, char* argv[]) {
         case 5:
             solver = std::make_unique<ParallelDLXSolver>(args.numThreads);
             break;
+        case 6:
+            if (!Fixed::isSupported(sudoku.getSize()))
+                std::cout << "No fixed-size kernel for " << sudoku.getSize()
+                          << "x" << sudoku.getSize() << ", using runtime backtracking.\n";
+            solver = std::make_unique<FixedSizeSolver>(args.numThreads);
+            break;
+        case 7: {
+            auto backtracking = std::make_unique<BacktrackingSolver>(
+                args.numThreads, BacktrackingSolver::CellOrder::MinimumRemaining);
+            backtracking->setNodePropagation(args.propagation >= 2);
+            solver = std::move(backtracking);
+            break;
+        }
+        case 8:
+            solver = std::make_unique<CDCLSolver>(args.numThreads);
+            break;
+        case 9: {
+            auto racing = std::make_unique<PortfolioSolver>(args.numThreads);
+            racing->addEngine("DLX", std::make_unique<DLXSolver>(1));
+            racing->addEngine("BacktrackingMRV", std::make_unique<BacktrackingSolver>(
+                1, BacktrackingSolver::CellOrder::MinimumRemaining));
+            racing->addEngine("CDCL", std::make_unique<CDCLSolver>(1));
+            portfolio = racing.get();
+            solver = std::move(racing);
+            break;
+        }
+        case 10: {
+            // Auto mode: a model retrained by the benchmark, else the default engines
+            SelectionModel model;
+            model.load(args.modelFile);
+            auto selecting = std::make_unique<AdaptiveSolver>(args.numThreads, std::move(model));
+            adaptive = selecting.get();
+            solver = std::move(selecting);
+            break;
+        }
+        case 11: {
+            auto bitboard = std::make_unique<BitboardSolver>(args.numThreads);
+            if (sudoku.getSize() == 9)
+                std::cout << "Bitboard kernel: " << BitboardSolver::kernelName(bitboard->getKernel()) << "\n";
+            else
+                std::cout << "No bitboard kernel for " << sudoku.getSize() << "x" << sudoku.getSize()
+                          << ", using DLX.\n";
+            solver = std::move(bitboard);
+            break;
+        }
         default:
             std::cerr << "Unknown solver mode.\n";
             return 1;
     }
 
-    if (!solver->solve(sudoku)) {
+    if (!solver->setValueOrder(valueOrder)) {
+        std::cerr << "This solver ignores -v " << args.valueOrder << ".\n";
+    }
+    if (!solver->setRestartPolicy(restartPolicy)) {
+        std::cerr << "This solver ignores -r " << args.restarts << ".\n";
+    }
+
+    PropagatingSolver* propagating = nullptr;
+    if (args.propagation >= 1) {
+        auto wrapped = std::make_unique<PropagatingSolver>(std::move(solver));
+        propagating = wrapped.get();
+        solver = std::move(wrapped);
+    }
+
+    bool solved = solver->solve(sudoku);
+    if (solver->getNodeCount() > 0) {
+        std::cout << "Search nodes: " << solver->getNodeCount() << "\n";
+    }
+    if (solver->getRestartCount() > 0) {
+        std::cout << "Restarts: " << solver->getRestartCount() << "\n";
+    }
+    if (propagating) {
+        std::cout << "Propagation filled " << propagating->getLastResult().cellsFilled << " cells"
+                  << (propagating->solvedByPropagation() ? " and solved the puzzle without search" : "")
+                  << ".\n";
+    }
+    if (adaptive) {
+        const AdaptiveSolver::Selection& selection = adaptive->getLastSelection();
+        if (selection.engine.empty()) std::cout << "Auto mode needed no search";
+        else std::cout << "Auto mode picked " << selection.engine << " with "
+                       << selection.numThreads << " threads";
+        std::cout << " (selection took " << selection.overheadMs << " ms).\n";
+    }
+    if (portfolio && !portfolio->getLastWinner().empty()) {
+        std::cout << "Portfolio answer from " << portfolio->getLastWinner() << ".\n";
+    }
+    if (!solved) {
         std::cerr << "Failed to solve sudoku.\n";
         return 1;
     }
@@ -7,6 +7,14 @@
 #include "solver/ParallelBruteForceSolver.hpp"
 #include "solver/DLXSolver.hpp"
 #include "solver/ParallelDLXSolver.hpp"
+#include "solver/FixedSizeSolver.hpp"
+#include "solver/BitboardSolver.hpp"
+#include "solver/LaneBatchSolver.hpp"
+#include "solver/PropagatingSolver.hpp"
+#include "solver/CDCLSolver.hpp"
+#include "solver/PortfolioSolver.hpp"
+#include "solver/SolverSession.hpp"
+#include "solver/SelectionModel.hpp"
 #include <iostream>
 
 int main() {
@@ -27,15 +35,134 @@ int main() {
 
     int numThreads = std::thread::hardware_concurrency(); // Automatically detect the number of CPU cores, or set it to a fixed value
 
+    // One worker pool for all parallel solvers, created before any timing
+    auto session = std::make_shared<SolverSession>(numThreads);
+
     manager.addSolver("Backtracking", std::make_unique<BacktrackingSolver>(1));
-    manager.addSolver("ParallelBacktracking", std::make_unique<ParallelBacktrackingSolver>(numThreads));
+    manager.addSolver("ParallelBacktracking", std::make_unique<ParallelBacktrackingSolver>(numThreads, session), numThreads);
     manager.addSolver("BruteForce", std::make_unique<BruteForceSolver>(1));
-    manager.addSolver("ParallelBruteForce", std::make_unique<ParallelBruteForceSolver>(numThreads));
+    manager.addSolver("ParallelBruteForce", std::make_unique<ParallelBruteForceSolver>(numThreads, session), numThreads);
     manager.addSolver("DLX", std::make_unique<DLXSolver>(1));
-    manager.addSolver("ParallelDLX", std::make_unique<ParallelDLXSolver>(numThreads));
+    manager.addSolver("ParallelDLX", std::make_unique<ParallelDLXSolver>(numThreads, session), numThreads);
+    if (numThreads > 2) {
+        // A second thread count for auto mode to choose from
+        manager.addSolver("ParallelDLX", std::make_unique<ParallelDLXSolver>(2, SolverSession::shared(2)), 2);
+    }
+    manager.addSolver("FixedSize", std::make_unique<FixedSizeSolver>(1));
+    manager.addSolver("Bitboard", std::make_unique<BitboardSolver>(1));
+    manager.addSolver("BacktrackingMRV", std::make_unique<BacktrackingSolver>(
+        1, BacktrackingSolver::CellOrder::MinimumRemaining));
+    manager.addSolver("Propagation+DLX", std::make_unique<PropagatingSolver>(
+        std::make_unique<DLXSolver>(1)));
+    manager.addSolver("Propagation+BacktrackingMRV", std::make_unique<PropagatingSolver>(
+        std::make_unique<BacktrackingSolver>(1, BacktrackingSolver::CellOrder::MinimumRemaining)));
+    manager.addSolver("CDCL", std::make_unique<CDCLSolver>(1));
+    manager.addSolver("Propagation+CDCL", std::make_unique<PropagatingSolver>(
+        std::make_unique<CDCLSolver>(1)));
+
+    auto portfolio = std::make_unique<PortfolioSolver>(3);
+    portfolio->addEngine("DLX", std::make_unique<DLXSolver>(1));
+    portfolio->addEngine("BacktrackingMRV", std::make_unique<BacktrackingSolver>(
+        1, BacktrackingSolver::CellOrder::MinimumRemaining));
+    portfolio->addEngine("CDCL", std::make_unique<CDCLSolver>(1));
+    manager.addSolver("Portfolio", std::move(portfolio), 3);
 
     manager.runBenchmarks();
-    manager.exportResultsCSV("../solution.txt");
+    manager.exportResultsCSV("../benchmark_results.csv");
+
+    // Retrain the engine selection of auto mode (-m 10) on this run
+    SelectionModel model = SelectionModel::fitFromCSV("../benchmark_results.csv");
+    if (!model.empty() && model.save("../selector_model.txt"))
+        std::cout << "Selection model with " << model.getCandidates().size()
+                  << " configurations written to ../selector_model.txt" << std::endl;
+
+    // Boards past 25x25, for the engines that scale to them
+    BenchmarkManager largeManager({
+        "../Test_Cases/36x36_easy.txt",
+        "../Test_Cases/36x36_hard.txt",
+        "../Test_Cases/36x36_expert.txt",
+        "../Test_Cases/49x49_easy.txt",
+        "../Test_Cases/49x49_hard.txt",
+        "../Test_Cases/64x64_easy.txt",
+        "../Test_Cases/64x64_hard.txt"
+    });
+    largeManager.addSolver("DLX", std::make_unique<DLXSolver>(1));
+    largeManager.addSolver("ParallelDLX", std::make_unique<ParallelDLXSolver>(numThreads, session), numThreads);
+    largeManager.addSolver("Propagation+DLX", std::make_unique<PropagatingSolver>(
+        std::make_unique<DLXSolver>(1)));
+    // Propagation inside DLX also keeps eliminations off the board out of the matrix
+    auto propagatedDLX = std::make_unique<DLXSolver>(1);
+    propagatedDLX->setPropagation(true);
+    largeManager.addSolver("DLX+MatrixPropagation", std::move(propagatedDLX));
+    largeManager.addSolver("CDCL", std::make_unique<CDCLSolver>(1));
+    largeManager.runBenchmarks();
+    largeManager.exportResultsCSV("../large_results.csv");
+
+    // Node count and time of each value order on the searching engines
+    BenchmarkManager orderManager(testFiles);
+    orderManager.addSolver("Backtracking", std::make_unique<BacktrackingSolver>(1));
+    orderManager.addSolver("BacktrackingMRV", std::make_unique<BacktrackingSolver>(
+        1, BacktrackingSolver::CellOrder::MinimumRemaining));
+    orderManager.addSolver("DLX", std::make_unique<DLXSolver>(1));
+    for (ValueOrder order : {ValueOrder::Ascending, ValueOrder::LeastConstraining,
+                             ValueOrder::Frequency, ValueOrder::Random}) {
+        std::cout << "Value order " << valueOrderName(order) << ":" << std::endl;
+        orderManager.setValueOrder(order);
+        orderManager.runBenchmarks();
+    }
+    orderManager.exportResultsCSV("../value_order_results.csv");
+
+    // Same engines with and without Luby restarts, for the slow tail
+    RestartPolicy luby;
+    luby.schedule = RestartPolicy::Schedule::Luby;
+    BenchmarkManager restartManager(testFiles);
+    for (bool restarting : {false, true}) {
+        auto dlx = std::make_unique<DLXSolver>(1);
+        auto mrv = std::make_unique<BacktrackingSolver>(1, BacktrackingSolver::CellOrder::MinimumRemaining);
+        if (restarting) {
+            dlx->setRestartPolicy(luby);
+            mrv->setRestartPolicy(luby);
+        }
+        restartManager.addSolver(restarting ? "DLX+Luby" : "DLX", std::move(dlx));
+        restartManager.addSolver(restarting ? "BacktrackingMRV+Luby" : "BacktrackingMRV", std::move(mrv));
+    }
+    restartManager.runBenchmarks();
+    restartManager.exportResultsCSV("../restart_results.csv");
+
+    // Throughput on many small puzzles, whole puzzles spread across workers
+    BenchmarkManager batchManager({
+        "../Test_Cases/9x9_easy.txt",
+        "../Test_Cases/9x9_medium.txt",
+        "../Test_Cases/9x9_hard.txt"
+    });
+    batchManager.addSolver("DLX", std::make_unique<DLXSolver>(1));
+    batchManager.addSolver("ParallelDLX", std::make_unique<ParallelDLXSolver>(numThreads, session), numThreads);
+    batchManager.addSolver("FixedSize", std::make_unique<FixedSizeSolver>(1));
+    batchManager.addSolver("Bitboard", std::make_unique<BitboardSolver>(1));
+    if (BitboardSolver::isKernelSupported(BitboardSolver::Kernel::Avx2))
+        batchManager.addSolver("BitboardAVX2", std::make_unique<BitboardSolver>(1, BitboardSolver::Kernel::Avx2));
+    batchManager.addSolver("LaneBatch", std::make_unique<LaneBatchSolver>(1));
+    batchManager.addSolver("LaneBatchPortable", std::make_unique<LaneBatchSolver>(1, BitboardSolver::Kernel::Portable));
+    batchManager.addSolver("BacktrackingMRV", std::make_unique<BacktrackingSolver>(
+        1, BacktrackingSolver::CellOrder::MinimumRemaining));
+
+    BatchOptions batchOptions;
+    batchOptions.numThreads = numThreads;
+    batchOptions.session = session;
+    batchManager.runBatchBenchmarks(1000, batchOptions);
+    batchManager.exportResultsCSV("../batch_results.csv");
+
+    // Heap allocations of warm solves; the engines below keep their
+    // matrices, stacks and scratch between puzzles
+    BenchmarkManager allocationManager(testFiles);
+    allocationManager.addSolver("DLX", std::make_unique<DLXSolver>(1));
+    allocationManager.addSolver("ParallelDLX", std::make_unique<ParallelDLXSolver>(numThreads, session), numThreads);
+    allocationManager.addSolver("Bitboard", std::make_unique<BitboardSolver>(1));
+    allocationManager.addSolver("LaneBatch", std::make_unique<LaneBatchSolver>(1));
+    allocationManager.addSolver("BacktrackingMRV", std::make_unique<BacktrackingSolver>(
+        1, BacktrackingSolver::CellOrder::MinimumRemaining));
+    allocationManager.runAllocationBenchmarks(5);
+    allocationManager.exportResultsCSV("../allocation_results.csv");
 
     return 0;
 }
@@ -0,0 +1,106 @@
+//src/solver/AdaptiveSolver.cpp
+#include "solver/AdaptiveSolver.hpp"
+#include "solver/BacktrackingSolver.hpp"
+#include "solver/BruteForceSolver.hpp"
+#include "solver/CDCLSolver.hpp"
+#include "solver/DLXSolver.hpp"
+#include "solver/FixedSizeSolver.hpp"
+#include "solver/BitboardSolver.hpp"
+#include "solver/ParallelBacktrackingSolver.hpp"
+#include "solver/ParallelBruteForceSolver.hpp"
+#include "solver/ParallelDLXSolver.hpp"
+#include <chrono>
+#include <iostream>
+
+AdaptiveSolver::AdaptiveSolver(int numThreads, SelectionModel model)
+    : numThreads_(numThreads), model(std::move(model)) {
+    std::cout << "AdaptiveSolver using up to " << numThreads << " threads .\n";
+}
+
+std::unique_ptr<SolverBase> AdaptiveSolver::clone() const {
+    auto copy = std::make_unique<AdaptiveSolver>(numThreads_, model);
+    copy->setCancellationToken(getCancellationToken());
+    return copy;
+}
+
+std::unique_ptr<SolverBase> AdaptiveSolver::makeEngine(const std::string& name, int numThreads) {
+    if (name == "Backtracking") return std::make_unique<BacktrackingSolver>(numThreads);
+    if (name == "BacktrackingMRV")
+        return std::make_unique<BacktrackingSolver>(numThreads, BacktrackingSolver::CellOrder::MinimumRemaining);
+    if (name == "BruteForce") return std::make_unique<BruteForceSolver>(numThreads);
+    if (name == "DLX") return std::make_unique<DLXSolver>(numThreads);
+    if (name == "FixedSize") return std::make_unique<FixedSizeSolver>(numThreads);
+    if (name == "Bitboard") return std::make_unique<BitboardSolver>(numThreads);
+    if (name == "CDCL") return std::make_unique<CDCLSolver>(numThreads);
+    if (name == "ParallelBacktracking") return std::make_unique<ParallelBacktrackingSolver>(numThreads);
+    if (name == "ParallelBruteForce") return std::make_unique<ParallelBruteForceSolver>(numThreads);
+    if (name == "ParallelDLX") return std::make_unique<ParallelDLXSolver>(numThreads);
+    return nullptr;
+}
+
+bool AdaptiveSolver::isKnownEngine(const std::string& name) {
+    static const char* const known[] = {
+        "Backtracking", "BacktrackingMRV", "BruteForce", "DLX", "FixedSize", "CDCL", "Bitboard",
+        "ParallelBacktracking", "ParallelBruteForce", "ParallelDLX"
+    };
+    for (const char* engine : known)
+        if (name == engine) return true;
+    return false;
+}
+
+const char* AdaptiveSolver::defaultEngine(const PuzzleFeatures& features) {
+    return features.size == 9 ? "Bitboard" : "DLX";
+}
+
+SolverBase* AdaptiveSolver::select(const Sudoku& sudoku, Sudoku& reduced) {
+    auto start = std::chrono::steady_clock::now();
+    reduced = sudoku;
+    lastSelection = Selection{};
+    lastSelection.features = PuzzleFeatures::extract(sudoku, propagator, reduced);
+    const PuzzleFeatures& features = lastSelection.features;
+
+    if (features.consistent && !features.solvedByPropagation) {
+        const SelectionModel::Candidate* choice = model.select(features, numThreads_);
+        lastSelection.engine = choice ? choice->engine : defaultEngine(features);
+        lastSelection.numThreads = choice ? choice->numThreads : 1;
+    }
+    lastSelection.overheadMs =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    if (lastSelection.engine.empty()) return nullptr;
+    auto& engine = engines[{lastSelection.engine, lastSelection.numThreads}];
+    if (!engine) {
+        engine = makeEngine(lastSelection.engine, lastSelection.numThreads);
+        if (!engine) engine = std::make_unique<DLXSolver>(1);
+    }
+    engine->setCancellationToken(getCancellationToken());
+    return engine.get();
+}
+
+bool AdaptiveSolver::solve(Sudoku& sudoku) {
+    Sudoku reduced;
+    SolverBase* engine = select(sudoku, reduced);
+    if (!lastSelection.features.consistent) return false;
+    if (engine && !engine->solve(reduced)) return false;
+    sudoku = reduced;
+    return true;
+}
+
+// Propagation only places forced values, so the reduced board has the
+// solutions of the original, and one it completes is the only one
+std::uint64_t AdaptiveSolver::countSolutions(const Sudoku& sudoku, std::uint64_t limit) {
+    if (limit == 0) return 0;
+    Sudoku reduced;
+    SolverBase* engine = select(sudoku, reduced);
+    if (!lastSelection.features.consistent) return 0;
+    return engine ? engine->countSolutions(reduced, limit) : 1;
+}
+
+std::uint64_t AdaptiveSolver::enumerate(const Sudoku& sudoku, const SolutionCallback& onSolution) {
+    Sudoku reduced;
+    SolverBase* engine = select(sudoku, reduced);
+    if (!lastSelection.features.consistent) return 0;
+    if (engine) return engine->enumerate(reduced, onSolution);
+    onSolution(reduced);
+    return 1;
+}
@@ -1,51 +1,307 @@
 //src/solver/BacktrackingSolver.cpp
 #include "solver/BacktrackingSolver.hpp"
+#include "core/SudokuUtils.hpp"
 #include <iostream>
+#include <climits>
 
+// A spent attempt unwinds like a dead end, leaving the board as it was
 bool BacktrackingSolver::solve(Sudoku& sudoku) {
-    auto emptyCells = sudoku.getEmptyCells();
-    return backtrack(sudoku, emptyCells, 0);
+    const ValueOrderer configuredOrder = valueOrderer;
+    std::uint64_t spent = 0;
+    bool solved = restartPolicy.run([&](std::uint64_t budget, unsigned seed) {
+        nodeBudget = budget;
+        randomTieBreak = restarts > 0;
+        tieBreak.seed(seed);
+        if (randomTieBreak && order == CellOrder::RowMajor &&
+            configuredOrder.getOrder() == ValueOrder::Ascending)
+            valueOrderer = ValueOrderer(ValueOrder::Random, seed);
+
+        bool found = run(sudoku, Enumeration{}) == 1;
+        spent += nodeCount;
+        if (found) return RestartPolicy::Outcome::Solved;
+        return budgetSpent ? RestartPolicy::Outcome::OutOfBudget : RestartPolicy::Outcome::Exhausted;
+    }, restarts);
+
+    valueOrderer = configuredOrder;
+    nodeBudget = 0;
+    randomTieBreak = false;
+    nodeCount = spent;
+    return solved;
+}
+
+bool BacktrackingSolver::overBudget() {
+    if (nodeBudget == 0 || nodeCount < nodeBudget) return false;
+    budgetSpent = true;
+    return true;
+}
+
+// Solutions go straight from the search board to the callback, so memory
+// does not grow with their number
+std::uint64_t BacktrackingSolver::enumerate(const Sudoku& sudoku, const SolutionCallback& onSolution) {
+    Sudoku board = sudoku;
+    Enumeration mode;
+    mode.onSolution = &onSolution;
+    mode.limit = UINT64_MAX;
+    return run(board, mode);
+}
+
+std::uint64_t BacktrackingSolver::countSolutions(const Sudoku& sudoku, std::uint64_t limit) {
+    if (limit == 0) return 0;
+    Sudoku board = sudoku;
+    Enumeration mode;
+    mode.limit = limit;
+    return run(board, mode);
+}
+
+// On the first solution with limit 1 the board is left solved; otherwise
+// the search unwinds and leaves it as it was
+std::uint64_t BacktrackingSolver::run(Sudoku& board, const Enumeration& mode) {
+    nodeCount = 0;
+    budgetSpent = false;
+    enumeration = mode;
+    enumeration.found = 0;
+    if (!SudokuUtils::hasConsistentGivens(board)) return 0;
+    if (valueOrderer.getOrder() != ValueOrder::Ascending) initValueOrder(board);
+
+    // Node propagation starts with a full pass at the root; every node
+    // after that only propagates from the cell it fills
+    if (nodePropagation && !propagator.propagate(board).consistent) {
+        propagator.rollback(board, {});
+        return 0;
+    }
+
+    bool stopped;
+    if (order == CellOrder::MinimumRemaining) {
+        initMRV(board);
+        stopped = searchMRV(board, openCells.size());
+    } else {
+        auto emptyCells = board.getEmptyCells();
+        stopped = backtrack(board, emptyCells, 0);
+    }
+    if (nodePropagation && !stopped) propagator.rollback(board, {});
+    return enumeration.found;
 }
 
-bool BacktrackingSolver::solveAll(Sudoku& sudoku, std::vector<Sudoku>& allSolutions) {
-    auto emptyCells = sudoku.getEmptyCells();
-    backtrackAll(sudoku, emptyCells, 0, allSolutions);
-    return !allSolutions.empty();
+bool BacktrackingSolver::setValueOrder(ValueOrder order, unsigned seed) {
+    valueOrderer = ValueOrderer(order, seed);
+    return true;
+}
+
+void BacktrackingSolver::initValueOrder(const Sudoku& board) {
+    int n = board.getSize();
+    ensurePeers(board);
+    orderedValues.resize(static_cast<size_t>(n) * n * n);
+    givenCount.assign(n + 1, 0);
+    for (int r = 0; r < n; ++r)
+        for (int c = 0; c < n; ++c) ++givenCount[board.getValue(r, c)];
+}
+
+// Writes the values of mask for cell to values in the configured order.
+// Candidates of empty peers come from the incremental masks during the MRV
+// search and from the board for the row-major one. Restart attempts after
+// the first break ties between equal scores at random.
+int BacktrackingSolver::orderValues(const Sudoku& board, int cell, Sudoku::Mask mask, int* values) {
+    const bool incremental = order == CellOrder::MinimumRemaining;
+    const int* cellPeers = &peers[cell * numPeers];
+    return valueOrderer.sort(mask, values, [&](int val) {
+        int score;
+        if (valueOrderer.getOrder() == ValueOrder::Frequency) {
+            score = -givenCount[val];
+        } else {
+            const Sudoku::Mask bit = Sudoku::Mask(1) << (val - 1);
+            score = 0;
+            for (int k = 0; k < numPeers; ++k) {
+                int peer = cellPeers[k];
+                if (board.getValue(peer / size, peer % size) != 0) continue;
+                Sudoku::Mask peerCandidates = incremental ? candidates[peer]
+                                                          : board.getCandidates(peer / size, peer % size);
+                if (peerCandidates & bit) ++score;
+            }
+        }
+        // A random low part orders equal scores at random and keeps the rest
+        if (randomTieBreak) score = score * TieBreakSpan + static_cast<int>(tieBreak() % TieBreakSpan);
+        return score;
+    });
+}
+
+// Returns true once the search should stop
+bool BacktrackingSolver::recordSolution(const Sudoku& board) {
+    ++enumeration.found;
+    if (enumeration.onSolution && !(*enumeration.onSolution)(board)) return true;
+    return enumeration.found >= enumeration.limit;
+}
+
+// Fills whatever the propagator can deduce from the value just written
+// into cell. The caller rolls back to a checkpoint taken before it, also
+// on failure.
+bool BacktrackingSolver::propagateNode(Sudoku& board, int cell) {
+    return !nodePropagation || propagator.propagateFrom(board, cell).consistent;
 }
 
 bool BacktrackingSolver::backtrack(Sudoku& board,
                                    const std::vector<std::pair<int, int>>& emptyCells,
                                    size_t index) {
-    if (index == emptyCells.size()) return true;
+    if (isCancelled() || overBudget()) return false;
+
+    // Skip cells already filled by node propagation
+    while (index < emptyCells.size() &&
+           board.getValue(emptyCells[index].first, emptyCells[index].second) != 0)
+        ++index;
+    if (index == emptyCells.size()) return recordSolution(board);
 
     auto [row, col] = emptyCells[index];
-    for (int val = 1; val <= board.getSize(); ++val) {
-        if (board.isValid(row, col, val)) {
-            board.setValue(row, col, val);
-            if (backtrack(board, emptyCells, index + 1)) return true;
-            board.setValue(row, col, 0);
-        }
+    const int n = board.getSize();
+    auto tryValue = [&](int val) {
+        ++nodeCount;
+        const ConstraintPropagator::Checkpoint propagated = propagator.checkpoint();
+        board.setValue(row, col, val);
+        if (propagateNode(board, row * n + col) && backtrack(board, emptyCells, index + 1)) return true;
+        if (nodePropagation) propagator.rollback(board, propagated);
+        board.setValue(row, col, 0);
+        return false;
+    };
+
+    if (valueOrderer.getOrder() != ValueOrder::Ascending) {
+        int* values = &orderedValues[index * n];
+        int count = orderValues(board, row * n + col, board.getCandidates(row, col), values);
+        for (int i = 0; i < count; ++i)
+            if (tryValue(values[i])) return true;
+        return false;
     }
+    for (int val = 1; val <= n; ++val)
+        if (board.isValid(row, col, val) && tryValue(val)) return true;
     return false;
 }
 
-void BacktrackingSolver::backtrackAll(Sudoku& board,
-                                      const std::vector<std::pair<int, int>>& emptyCells,
-                                      size_t index, std::vector<Sudoku>& solutions) {
-    if (index == emptyCells.size()) {
-        solutions.push_back(board);
-        return;
+void BacktrackingSolver::ensurePeers(const Sudoku& board) {
+    if (board.getSize() != size) {
+        size = board.getSize();
+        peers = SudokuUtils::buildPeers(board, numPeers);
     }
+}
 
-    auto [row, col] = emptyCells[index];
-    for (int val = 1; val <= board.getSize(); ++val) {
-        if (board.isValid(row, col, val)) {
-            board.setValue(row, col, val);
-            backtrackAll(board, emptyCells, index + 1, solutions);
-            board.setValue(row, col, 0);
+void BacktrackingSolver::initMRV(const Sudoku& board) {
+    ensurePeers(board);
+
+    candidates.assign(size * size, 0);
+    openCells.clear();
+    trail.clear();
+    for (int r = 0; r < size; ++r)
+        for (int c = 0; c < size; ++c)
+            if (board.getValue(r, c) == 0) {
+                candidates[r * size + c] = board.getCandidates(r, c);
+                openCells.push_back(r * size + c);
+            }
+}
+
+// Place val and strike it from every peer. Returns false if an open peer
+// is left without candidates; the caller undoes the placement either way.
+bool BacktrackingSolver::assign(Sudoku& board, int cell, int val) {
+    ++nodeCount;
+    board.setValue(cell / size, cell % size, val);
+    return strike(board, cell, val);
+}
+
+bool BacktrackingSolver::strike(Sudoku& board, int cell, int val) {
+    const Sudoku::Mask bit = Sudoku::Mask(1) << (val - 1);
+    const int* cellPeers = &peers[cell * numPeers];
+    bool alive = true;
+    for (int k = 0; k < numPeers; ++k) {
+        int peer = cellPeers[k];
+        if (candidates[peer] & bit) {
+            candidates[peer] &= ~bit;
+            trail.push_back({peer, bit});
+            if (candidates[peer] == 0 && board.getValue(peer / size, peer % size) == 0)
+                alive = false;
+        }
+    }
+    return alive;
+}
+
+// Moves the cells node propagation filled from position first of its
+// filled cells on out of the open range and narrows their peers, so the
+// incremental candidates match the board again
+bool BacktrackingSolver::closeForced(Sudoku& board, size_t first, size_t& openCount) {
+    const std::vector<int>& forced = propagator.getFilledCells();
+    bool alive = true;
+    for (size_t f = first; f < forced.size(); ++f) {
+        const int cell = forced[f];
+        for (size_t i = 0; i < openCount; ++i) {
+            if (openCells[i] == cell) {
+                std::swap(openCells[i], openCells[--openCount]);
+                break;
+            }
+        }
+        alive = strike(board, cell, board.getValue(cell / size, cell % size)) && alive;
+    }
+    return alive;
+}
+
+void BacktrackingSolver::undo(Sudoku& board, int cell, size_t trailMark) {
+    while (trail.size() > trailMark) {
+        candidates[trail.back().cell] |= trail.back().removed;
+        trail.pop_back();
+    }
+    board.setValue(cell / size, cell % size, 0);
+}
+
+// Returns true to stop the search, see recordSolution. Cancellation
+// instead unwinds it like a dead end.
+bool BacktrackingSolver::searchMRV(Sudoku& board, size_t openCount) {
+    if (openCount == 0) return recordSolution(board);
+    if (isCancelled() || overBudget()) return false;
+
+    size_t best = 0;
+    int bestCount = INT_MAX;
+    unsigned ties = 0;
+    for (size_t i = 0; i < openCount; ++i) {
+        int count = SudokuUtils::countBits(candidates[openCells[i]]);
+        if (count < bestCount) {
+            bestCount = count;
+            best = i;
+            ties = 1;
+            if (count <= 1) break;
+        } else if (randomTieBreak && count == bestCount && tieBreak() % ++ties == 0) {
+            best = i;
         }
     }
+    if (bestCount == 0) return false;
+
+    // Move the chosen cell past the open range for the deeper levels
+    std::swap(openCells[best], openCells[openCount - 1]);
+    int cell = openCells[openCount - 1];
+
+    auto tryValue = [&](int val) {
+        size_t mark = trail.size();
+        size_t open = openCount - 1;
+        const ConstraintPropagator::Checkpoint propagated = propagator.checkpoint();
+        if (assign(board, cell, val) &&
+            propagateNode(board, cell) && closeForced(board, propagated.filled, open) &&
+            searchMRV(board, open))
+            return true;
+        undo(board, cell, mark);
+        if (nodePropagation) propagator.rollback(board, propagated);
+        return false;
+    };
+
+    if (valueOrderer.getOrder() != ValueOrder::Ascending) {
+        // openCount strictly shrinks with depth, so it names this level's slice
+        int* values = &orderedValues[(openCount - 1) * size];
+        int count = orderValues(board, cell, candidates[cell], values);
+        for (int i = 0; i < count; ++i)
+            if (tryValue(values[i])) return true;
+        return false;
+    }
+
+    Sudoku::Mask remaining = candidates[cell];
+    while (remaining) {
+        Sudoku::Mask bit = remaining & (~remaining + 1);
+        remaining ^= bit;
+        if (tryValue(SudokuUtils::lowestValue(bit))) return true;
+    }
+    return false;
 }
-BacktrackingSolver::BacktrackingSolver(int numThreads) {
+
+BacktrackingSolver::BacktrackingSolver(int numThreads, CellOrder order) : order(order) {
     std::cout << "BacktrackingSolver using " << numThreads << " threads .\n";
 }
@@ -0,0 +1,416 @@
+//src/solver/BitboardSolver.cpp
+#include "solver/BitboardSolver.hpp"
+#include "core/SudokuUtils.hpp"
+#include <iostream>
+
+namespace {
+
+// Digit d (0-based) owns lanes 4d..4d+2 of cand, lane b holding rows
+// 3b..3b+2 as bits 9 * (row % 3) + col. Lane 4d+3 and plane 9 stay zero, so
+// that a 256-bit vector covers two whole planes.
+struct Planes {
+    alignas(32) std::uint32_t cand[40];
+    std::uint32_t solved[4];
+};
+
+constexpr int NumDigits = 9;
+constexpr std::uint32_t BandMask = 0x7FFFFFF;
+constexpr std::uint32_t RowMask[3] = {0x1FF, 0x1FF << 9, 0x1FF << 18};
+constexpr std::uint32_t BoxMask[3] = {0x1C0E07, 0x1C0E07 << 3, 0x1C0E07 << 6};
+
+struct LiveLanes {
+    alignas(32) std::uint32_t mask[40] = {};
+    LiveLanes() {
+        for (int d = 0; d < NumDigits; ++d)
+            for (int b = 0; b < 3; ++b) mask[4 * d + b] = ~0u;
+    }
+};
+const LiveLanes liveLanes;
+
+#if defined(__GNUC__) && !defined(__clang__)
+// V8 values never cross a call boundary: the helpers taking them are all
+// inlined into the AVX2 entry point
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+typedef std::uint32_t V4 __attribute__((vector_size(16)));
+typedef std::uint32_t V8 __attribute__((vector_size(32)));
+
+// Every kernel helper is forced inline, so that the AVX2 entry point below
+// compiles all of it for AVX2
+#define BITBOARD_INLINE inline __attribute__((always_inline))
+
+template <typename V>
+BITBOARD_INLINE V load(const std::uint32_t* p) {
+    V v;
+    __builtin_memcpy(&v, p, sizeof(V));
+    return v;
+}
+
+template <typename V>
+BITBOARD_INLINE void store(std::uint32_t* p, V v) {
+    __builtin_memcpy(p, &v, sizeof(V));
+}
+
+template <typename V>
+BITBOARD_INLINE V splat(std::uint32_t x) {
+    return V{} + x;
+}
+
+// All ones in the lanes that are zero
+template <typename V>
+BITBOARD_INLINE V zeroLanes(V v) {
+    return (V)(v == 0);
+}
+
+template <typename V>
+BITBOARD_INLINE bool any(V v) {
+    std::uint32_t bits = 0;
+    for (unsigned i = 0; i < sizeof(V) / 4; ++i) bits |= v[i];
+    return bits != 0;
+}
+
+// Lane b of every plane takes lane (b + 1) % 3 of the same plane; the
+// padding lane stays in place
+BITBOARD_INLINE V4 nextBand(V4 v) {
+#ifdef __clang__
+    return __builtin_shufflevector(v, v, 1, 2, 0, 3);
+#else
+    return __builtin_shuffle(v, V4{1, 2, 0, 3});
+#endif
+}
+
+BITBOARD_INLINE V8 nextBand(V8 v) {
+#ifdef __clang__
+    return __builtin_shufflevector(v, v, 1, 2, 0, 3, 5, 6, 4, 7);
+#else
+    return __builtin_shuffle(v, V8{1, 2, 0, 3, 5, 6, 4, 7});
+#endif
+}
+
+// Column bits 0..8 repeated for the three rows of a band
+template <typename V>
+BITBOARD_INLINE V spreadColumns(V columns) {
+    return columns | (columns << 9) | (columns << 18);
+}
+
+// Columns with at least one / at least two cells of x, over all three
+// bands, in every lane of the plane
+template <typename V>
+BITBOARD_INLINE void countColumns(V x, V& ones, V& twos) {
+    const V a = x & 0x1FF, b = (x >> 9) & 0x1FF, c = (x >> 18) & 0x1FF;
+    const V o0 = a | b | c, t0 = (a & b) | (a & c) | (b & c);
+    const V o1 = nextBand(o0), o2 = nextBand(o1);
+    ones = o0 | o1 | o2;
+    twos = t0 | nextBand(t0) | nextBand(nextBand(t0)) | (o0 & o1) | (o0 & o2) | (o1 & o2);
+}
+
+// Lanes 0..2 of the planes, accumulated over the 128-bit halves of v
+template <typename V>
+BITBOARD_INLINE void foldPlanes(V onesV, V twosV, std::uint32_t* ones, std::uint32_t* twos) {
+    constexpr int lanes = sizeof(V) / 4;
+    for (int b = 0; b < 3; ++b) ones[b] = twos[b] = 0;
+    for (int k = 0; k < lanes; k += 4)
+        for (int b = 0; b < 3; ++b) {
+            twos[b] |= twosV[k + b] | (ones[b] & onesV[k + b]);
+            ones[b] |= onesV[k + b];
+        }
+}
+
+// The three bands of a board-wide plane in every digit plane of a vector
+template <typename V>
+BITBOARD_INLINE V replicate(const std::uint32_t* band) {
+    V v = {};
+    for (unsigned i = 0; i < sizeof(V) / 4; ++i)
+        if ((i & 3) < 3) v[i] = band[i & 3];
+    return v;
+}
+
+// Runs singles and box/line reductions until nothing changes. False once a
+// cell, or a digit in some unit, is left without a place, or a digit is
+// placed twice in a unit.
+template <typename V>
+BITBOARD_INLINE bool propagateKernel(Planes& p) {
+    constexpr int lanes = sizeof(V) / 4;
+    constexpr int chunks = (4 * NumDigits + lanes - 1) / lanes;   // plane 9 only as padding
+
+    while (true) {
+        const V solved = replicate<V>(p.solved);
+
+        // 1. A solved cell strikes its digit from its row, box and column
+        V clash = {};
+        for (int i = 0; i < chunks; ++i) {
+            const V x = load<V>(p.cand + i * lanes);
+            const V placed = x & solved;
+            V columns, twice;
+            countColumns(placed, columns, twice);
+            clash |= twice;
+            V hits = spreadColumns(columns);
+            for (int r = 0; r < 3; ++r) {
+                const V y = (placed >> (9 * r)) & 0x1FF;
+                clash |= ~zeroLanes(y & (y - 1));
+                hits |= ~zeroLanes(y) & splat<V>(RowMask[r]);
+            }
+            for (int b = 0; b < 3; ++b) {
+                const V y = placed & splat<V>(BoxMask[b]);
+                clash |= ~zeroLanes(y & (y - 1));
+                hits |= ~zeroLanes(y) & splat<V>(BoxMask[b]);
+            }
+            store(p.cand + i * lanes, x & (~hits | placed));
+        }
+        if (any(clash)) return false;
+
+        // 2. Naked singles, counting candidates per cell over the planes
+        V onesV = {}, twosV = {};
+        for (int i = 0; i < chunks; ++i) {
+            const V x = load<V>(p.cand + i * lanes);
+            twosV |= onesV & x;
+            onesV |= x;
+        }
+        std::uint32_t ones[3], twos[3];
+        foldPlanes(onesV, twosV, ones, twos);
+        bool changed = false;
+        for (int b = 0; b < 3; ++b) {
+            if (~ones[b] & BandMask) return false;
+            const std::uint32_t singles = ones[b] & ~twos[b] & ~p.solved[b];
+            if (singles) {
+                p.solved[b] |= singles;
+                changed = true;
+            }
+        }
+        if (changed) continue;
+
+        // 3. Hidden singles: the only place left for a digit in a unit
+        alignas(32) std::uint32_t hidden[40];
+        V empty = {}, hiddenOnes = {}, hiddenTwos = {};
+        for (int i = 0; i < chunks; ++i) {
+            const V x = load<V>(p.cand + i * lanes);
+            const V live = load<V>(liveLanes.mask + i * lanes);
+            V columns, twice;
+            countColumns(x, columns, twice);
+            empty |= ~zeroLanes(~columns & 0x1FF) & live;
+            V h = x & spreadColumns(columns & ~twice);
+            for (int r = 0; r < 3; ++r) {
+                const V y = (x >> (9 * r)) & 0x1FF;
+                empty |= zeroLanes(y) & live;
+                h |= zeroLanes(y & (y - 1)) & (y << (9 * r));
+            }
+            for (int b = 0; b < 3; ++b) {
+                const V y = x & splat<V>(BoxMask[b]);
+                empty |= zeroLanes(y) & live;
+                h |= zeroLanes(y & (y - 1)) & y;
+            }
+            h &= ~solved;
+            hiddenTwos |= hiddenOnes & h;
+            hiddenOnes |= h;
+            store(hidden + i * lanes, h);
+        }
+        if (any(empty)) return false;
+        std::uint32_t hiddenAny[3], hiddenTwice[3];
+        foldPlanes(hiddenOnes, hiddenTwos, hiddenAny, hiddenTwice);
+        // A cell that is the only place for two digits is a dead end
+        if (hiddenTwice[0] | hiddenTwice[1] | hiddenTwice[2]) return false;
+        if (hiddenAny[0] | hiddenAny[1] | hiddenAny[2]) {
+            const V placedNow = replicate<V>(hiddenAny);
+            for (int i = 0; i < chunks; ++i) {
+                const V x = load<V>(p.cand + i * lanes);
+                store(p.cand + i * lanes, (x & ~placedNow) | load<V>(hidden + i * lanes));
+            }
+            for (int b = 0; b < 3; ++b) p.solved[b] |= hiddenAny[b];
+            continue;
+        }
+
+        // 4. Box/line reductions. Within a band: a box whose candidates for
+        // a digit sit in one row clears the rest of that row, and a row
+        // whose candidates sit in one box clears the rest of that box. The
+        // same across bands for columns.
+        V cleared = {};
+        for (int i = 0; i < chunks; ++i) {
+            const V x = load<V>(p.cand + i * lanes);
+            // segment(row, box): the row's three cells in the box hold candidates
+            auto segment = [&](int r, int b) { return ~zeroLanes((x >> (9 * r + 3 * b)) & 7); };
+            V clear = {};
+            for (int k = 0; k < 3; ++k) {
+                const V s0 = segment(0, k), s1 = segment(1, k), s2 = segment(2, k);
+                clear |= (s0 & ~s1 & ~s2) & splat<V>(RowMask[0] & ~BoxMask[k]);
+                clear |= (s1 & ~s0 & ~s2) & splat<V>(RowMask[1] & ~BoxMask[k]);
+                clear |= (s2 & ~s0 & ~s1) & splat<V>(RowMask[2] & ~BoxMask[k]);
+                const V t0 = segment(k, 0), t1 = segment(k, 1), t2 = segment(k, 2);
+                clear |= (t0 & ~t1 & ~t2) & splat<V>(BoxMask[0] & ~RowMask[k]);
+                clear |= (t1 & ~t0 & ~t2) & splat<V>(BoxMask[1] & ~RowMask[k]);
+                clear |= (t2 & ~t0 & ~t1) & splat<V>(BoxMask[2] & ~RowMask[k]);
+            }
+
+            const V columns = (x | (x >> 9) | (x >> 18)) & 0x1FF;
+            const V next = nextBand(columns), after = nextBand(next);
+            const V onlyThisBand = columns & ~next & ~after;
+            V inOneColumn = {}, otherColumns = {};
+            for (int stack = 0; stack < 3; ++stack) {
+                const V stackColumns = splat<V>(7u << (3 * stack));
+                const V inBox = columns & stackColumns;
+                inOneColumn |= ~zeroLanes(inBox) & zeroLanes(inBox & (inBox - 1)) & inBox;
+                otherColumns |= ~zeroLanes(onlyThisBand & stackColumns) & (stackColumns & ~onlyThisBand);
+            }
+            const V fromOtherBands = nextBand(inOneColumn) | nextBand(nextBand(inOneColumn));
+            clear |= spreadColumns(fromOtherBands | otherColumns);
+
+            cleared |= x & clear;
+            store(p.cand + i * lanes, x & ~clear);
+        }
+        if (!any(cleared)) return true;
+    }
+}
+
+using PropagateFn = bool (*)(Planes&);
+
+bool propagatePortable(Planes& p) {
+    return propagateKernel<V4>(p);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BITBOARD_HAS_AVX2 1
+__attribute__((target("avx2"))) bool propagateAvx2(Planes& p) {
+    return propagateKernel<V8>(p);
+}
+#endif
+
+void place(Planes& p, int band, std::uint32_t bit, int digit) {
+    for (int d = 0; d < NumDigits; ++d)
+        if (d != digit) p.cand[4 * d + band] &= ~bit;
+    p.solved[band] |= bit;
+}
+
+struct Search {
+    PropagateFn propagate;
+    const CancellationToken* stop;
+    std::uint64_t limit;
+    std::uint64_t found = 0;
+    std::uint64_t nodes = 0;
+    Planes solution;
+
+    // Returns true once the search should stop
+    bool run(Planes& p) {
+        if (!propagate(p)) return false;
+        if ((p.solved[0] & p.solved[1] & p.solved[2]) == BandMask) {
+            if (found++ == 0) solution = p;
+            return found >= limit;
+        }
+        if (stop && stop->isCancelled()) return true;
+
+        // Fewest candidates first: two, then three, then any open cell
+        std::uint32_t c1[3] = {}, c2[3] = {}, c3[3] = {}, c4[3] = {};
+        for (int d = 0; d < NumDigits; ++d)
+            for (int b = 0; b < 3; ++b) {
+                const std::uint32_t x = p.cand[4 * d + b] & ~p.solved[b];
+                c4[b] |= c3[b] & x;
+                c3[b] |= c2[b] & x;
+                c2[b] |= c1[b] & x;
+                c1[b] |= x;
+            }
+        std::uint32_t two[3], three[3];
+        for (int b = 0; b < 3; ++b) {
+            two[b] = c2[b] & ~c3[b];
+            three[b] = c3[b] & ~c4[b];
+        }
+        int band = -1;
+        std::uint32_t pick = 0;
+        for (const std::uint32_t* cells : {two, three, c1}) {
+            for (int b = 0; b < 3 && band < 0; ++b) {
+                if (cells[b]) {
+                    band = b;
+                    pick = cells[b] & (~cells[b] + 1);
+                }
+            }
+            if (band >= 0) break;
+        }
+
+        for (int d = 0; d < NumDigits; ++d) {
+            if (!(p.cand[4 * d + band] & pick)) continue;
+            ++nodes;
+            Planes child = p;
+            place(child, band, pick, d);
+            if (run(child)) return true;
+        }
+        return false;
+    }
+};
+
+}
+
+bool BitboardSolver::isKernelSupported(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::Avx2:
+#ifdef BITBOARD_HAS_AVX2
+            return __builtin_cpu_supports("avx2");
+#else
+            return false;
+#endif
+        default:
+            return true;
+    }
+}
+
+const char* BitboardSolver::kernelName(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::Portable: return "portable";
+        case Kernel::Avx2: return "avx2";
+        default: return "auto";
+    }
+}
+
+std::uint64_t BitboardSolver::run(Sudoku& board, std::uint64_t limit) {
+    nodeCount = 0;
+    if (!SudokuUtils::hasConsistentGivens(board)) return 0;
+
+    Planes planes = {};
+    for (int d = 0; d < NumDigits; ++d)
+        for (int b = 0; b < 3; ++b) planes.cand[4 * d + b] = BandMask;
+    for (int r = 0; r < 9; ++r)
+        for (int c = 0; c < 9; ++c) {
+            int val = board.getValue(r, c);
+            if (val != 0) place(planes, r / 3, 1u << (9 * (r % 3) + c), val - 1);
+        }
+
+    Search search;
+#ifdef BITBOARD_HAS_AVX2
+    search.propagate = kernel == Kernel::Avx2 ? propagateAvx2 : propagatePortable;
+#else
+    search.propagate = propagatePortable;
+#endif
+    search.stop = cancellationToken();
+    search.limit = limit;
+    search.run(planes);
+    nodeCount = search.nodes;
+    if (search.stop && search.stop->isCancelled() && search.found < limit) return 0;
+
+    if (search.found > 0 && limit == 1) {
+        for (int r = 0; r < 9; ++r)
+            for (int c = 0; c < 9; ++c) {
+                const std::uint32_t bit = 1u << (9 * (r % 3) + c);
+                for (int d = 0; d < NumDigits; ++d)
+                    if (search.solution.cand[4 * d + r / 3] & bit) board.setValue(r, c, d + 1);
+            }
+    }
+    return search.found;
+}
+
+bool BitboardSolver::solve(Sudoku& sudoku) {
+    if (sudoku.getSize() == 9) return run(sudoku, 1) == 1;
+
+    return fallback.solve(sudoku);
+}
+
+std::uint64_t BitboardSolver::countSolutions(const Sudoku& sudoku, std::uint64_t limit) {
+    if (limit == 0) return 0;
+    if (sudoku.getSize() == 9) {
+        Sudoku board = sudoku;
+        return run(board, limit);
+    }
+
+    return fallback.countSolutions(sudoku, limit);
+}
+
+BitboardSolver::BitboardSolver(int numThreads, Kernel kernel)
+    : kernel(kernel == Kernel::Avx2 && isKernelSupported(kernel) ? Kernel::Avx2 : Kernel::Portable) {
+    std::cout << "BitboardSolver using " << numThreads << " threads .\n";
+}
@@ -1,26 +1,26 @@
 //src/solver/BruteForceSolver.cpp
 #include "solver/BruteForceSolver.hpp"
-#include <functional> 
+#include "solver/SearchStack.hpp"
+#include "core/SudokuUtils.hpp"
 #include <iostream>
 
 bool BruteForceSolver::solve(Sudoku& sudoku) {
-    auto emptyCells = sudoku.getEmptyCells();
-
-    std::function<bool(size_t)> dfs = [&](size_t index) {
-        if (index == emptyCells.size()) return true;
-
-        auto [row, col] = emptyCells[index];
-        for (int val = 1; val <= sudoku.getSize(); ++val) {
-            if (sudoku.isValid(row, col, val)) {
-                sudoku.setValue(row, col, val);
-                if (dfs(index + 1)) return true;
-                sudoku.setValue(row, col, 0);
-            }
-        }
-        return false;
-    };
+    SearchStack stack(sudoku, valueOrderer);
+    SearchStack::Branch branch = stack.root(sudoku);
+    bool solved = stack.run(branch, [](const Sudoku&) { return true; },
+                            [this]() { return isCancelled(); });
+    if (solved) sudoku = branch.board;
+    return solved;
+}
 
-    return dfs(0);
+std::uint64_t BruteForceSolver::countSolutions(const Sudoku& sudoku, std::uint64_t limit) {
+    if (limit == 0 || !SudokuUtils::hasConsistentGivens(sudoku)) return 0;
+    SearchStack stack(sudoku, valueOrderer);
+    SearchStack::Branch branch = stack.root(sudoku);
+    std::uint64_t found = 0;
+    stack.run(branch, [&](const Sudoku&) { return ++found >= limit; },
+              [this]() { return isCancelled(); });
+    return found;
 }
 
 BruteForceSolver::BruteForceSolver(int numThreads) {
@@ -0,0 +1,128 @@
+//src/solver/CDCLSolver.cpp
+#include "solver/CDCLSolver.hpp"
+#include "core/SudokuUtils.hpp"
+#include <iostream>
+
+namespace {
+// Larger groups get the sequential at-most-one encoding, linear in the
+// group size, instead of the quadratic pairwise one
+constexpr std::size_t pairwiseLimit = 8;
+}
+
+bool CDCLSolver::solve(Sudoku& sudoku) {
+    if (!SudokuUtils::hasConsistentGivens(sudoku) || !encode(sudoku)) return false;
+    if (core.solve(cancellationToken()) != SatCore::Result::Satisfiable) return false;
+
+    for (int cell = 0; cell < size * size; ++cell)
+        for (int val = 1; val <= size; ++val) {
+            int var = varOf[cell * size + val - 1];
+            if (var >= 0 && core.getValue(var)) sudoku.setValue(cell / size, cell % size, val);
+        }
+    return true;
+}
+
+std::uint64_t CDCLSolver::countSolutions(const Sudoku& sudoku, std::uint64_t limit) {
+    if (limit == 0 || !SudokuUtils::hasConsistentGivens(sudoku) || !encode(sudoku)) return 0;
+
+    std::uint64_t found = 0;
+    std::vector<SatCore::Lit> block;
+    while (core.solve(cancellationToken()) == SatCore::Result::Satisfiable) {
+        if (++found >= limit) break;
+        // Some cell differs in every further solution; a board without
+        // open cells has no other one
+        block.clear();
+        for (int var : varOf)
+            if (var >= 0 && core.getValue(var)) block.push_back(SatCore::negative(var));
+        if (block.empty() || !core.addClause(block)) break;
+    }
+    return found;
+}
+
+// Returns false as soon as the encoding is known to be unsatisfiable
+bool CDCLSolver::encode(const Sudoku& sudoku) {
+    core = SatCore();
+    size = sudoku.getSize();
+    varOf.assign(size * size * size, -1);
+
+    // Cells: exactly one of the remaining candidates
+    std::vector<SatCore::Lit> lits;
+    for (int cell = 0; cell < size * size; ++cell) {
+        if (sudoku.getValue(cell / size, cell % size) != 0) continue;
+        lits.clear();
+        for (Sudoku::Mask m = sudoku.getCandidates(cell / size, cell % size); m; m &= m - 1) {
+            int var = core.newVar();
+            varOf[cell * size + SudokuUtils::lowestValue(m) - 1] = var;
+            lits.push_back(SatCore::positive(var));
+        }
+        if (!exactlyOne(lits)) return false;
+    }
+
+    // Units: every missing value exactly once. The at-least-one side is
+    // implied but gives the hidden singles to unit propagation.
+    const std::vector<int> units = SudokuUtils::buildUnits(sudoku);
+    for (int u = 0; u < 3 * size; ++u) {
+        const int* cells = &units[u * size];
+        const bool isBox = u >= 2 * size;
+
+        Sudoku::Mask placed = 0;
+        for (int k = 0; k < size; ++k) {
+            int val = sudoku.getValue(cells[k] / size, cells[k] % size);
+            if (val != 0) placed |= Sudoku::Mask(1) << (val - 1);
+        }
+
+        for (Sudoku::Mask m = sudoku.getFullMask() & ~placed; m; m &= m - 1) {
+            int val = SudokuUtils::lowestValue(m);
+            lits.clear();
+            std::vector<int> at;
+            for (int k = 0; k < size; ++k) {
+                int var = varOf[cells[k] * size + val - 1];
+                if (var < 0) continue;
+                lits.push_back(SatCore::positive(var));
+                at.push_back(cells[k]);
+            }
+            if (!core.addClause(lits)) return false;
+            if (lits.size() > pairwiseLimit) {
+                if (!atMostOne(lits)) return false;
+                continue;
+            }
+
+            for (size_t a = 0; a < lits.size(); ++a)
+                for (size_t b = a + 1; b < lits.size(); ++b) {
+                    if (isBox && (at[a] / size == at[b] / size || at[a] % size == at[b] % size))
+                        continue;
+                    if (!core.addClause({lits[a] ^ 1, lits[b] ^ 1})) return false;
+                }
+        }
+    }
+    return true;
+}
+
+bool CDCLSolver::exactlyOne(const std::vector<SatCore::Lit>& lits) {
+    return core.addClause(lits) && atMostOne(lits);
+}
+
+bool CDCLSolver::atMostOne(const std::vector<SatCore::Lit>& lits) {
+    if (lits.size() <= pairwiseLimit) {
+        for (size_t a = 0; a < lits.size(); ++a)
+            for (size_t b = a + 1; b < lits.size(); ++b)
+                if (!core.addClause({lits[a] ^ 1, lits[b] ^ 1})) return false;
+        return true;
+    }
+
+    // Sinz' sequential counter: s_i is true once one of lits[0..i] is
+    SatCore::Lit prev = SatCore::positive(core.newVar());
+    if (!core.addClause({lits[0] ^ 1, prev})) return false;
+    for (size_t i = 1; i + 1 < lits.size(); ++i) {
+        SatCore::Lit next = SatCore::positive(core.newVar());
+        if (!core.addClause({lits[i] ^ 1, next}) ||
+            !core.addClause({prev ^ 1, next}) ||
+            !core.addClause({lits[i] ^ 1, prev ^ 1}))
+            return false;
+        prev = next;
+    }
+    return core.addClause({lits.back() ^ 1, prev ^ 1});
+}
+
+CDCLSolver::CDCLSolver(int numThreads) {
+    std::cout << "CDCLSolver using " << numThreads << " threads .\n";
+}
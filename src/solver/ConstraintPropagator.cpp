@@ -0,0 +1,254 @@
+//src/solver/ConstraintPropagator.cpp
+#include "solver/ConstraintPropagator.hpp"
+#include "core/SudokuUtils.hpp"
+
+void ConstraintPropagator::init(const Sudoku& sudoku) {
+    if (sudoku.getSize() != size) {
+        size = sudoku.getSize();
+        boxSize = sudoku.getBoxSize();
+        peers = SudokuUtils::buildPeers(sudoku, numPeers);
+        units = SudokuUtils::buildUnits(sudoku);
+    }
+
+    candidates.assign(size * size, 0);
+    filledCells.clear();
+    trail.clear();
+    nakedQueue.clear();
+    for (int r = 0; r < size; ++r)
+        for (int c = 0; c < size; ++c) {
+            const int cell = r * size + c;
+            candidates[cell] = sudoku.getCandidates(r, c);
+            if (sudoku.getValue(r, c) == 0 && SudokuUtils::countBits(candidates[cell]) <= 1)
+                nakedQueue.push_back(cell);
+        }
+
+    // The first pass looks at every value of every unit
+    hiddenDirty.assign(3 * size, sudoku.getFullMask());
+    reductionDirty.assign(3 * size, sudoku.getFullMask());
+    hiddenQueue.clear();
+    reductionQueue.clear();
+    for (int u = 3 * size - 1; u >= 0; --u) {
+        hiddenQueue.push_back(u);
+        reductionQueue.push_back(u);
+    }
+}
+
+PropagationResult ConstraintPropagator::propagate(Sudoku& sudoku) {
+    init(sudoku);
+
+    bool ok = SudokuUtils::hasConsistentGivens(sudoku) && drain(sudoku);
+    clearPending();
+
+    PropagationResult result;
+    result.consistent = ok;
+    result.cellsFilled = static_cast<int>(filledCells.size());
+    return result;
+}
+
+PropagationResult ConstraintPropagator::propagateFrom(Sudoku& sudoku, int cell) {
+    const std::size_t before = filledCells.size();
+    const Sudoku::Mask bit = Sudoku::Mask(1) << (sudoku.getValue(cell / size, cell % size) - 1);
+
+    // A value the propagator already ruled out is a contradiction as is
+    bool ok = (candidates[cell] & bit) != 0;
+    if (ok) {
+        setCandidates(cell, 0);
+        ok = strikePeers(cell, bit) && drain(sudoku);
+    }
+    clearPending();
+
+    PropagationResult result;
+    result.consistent = ok;
+    result.cellsFilled = static_cast<int>(filledCells.size() - before);
+    return result;
+}
+
+void ConstraintPropagator::rollback(Sudoku& sudoku, const Checkpoint& mark) {
+    while (filledCells.size() > mark.filled) {
+        const int cell = filledCells.back();
+        sudoku.setValue(cell / size, cell % size, 0);
+        filledCells.pop_back();
+    }
+    while (trail.size() > mark.trail) {
+        candidates[trail.back().cell] = trail.back().previous;
+        trail.pop_back();
+    }
+}
+
+// Queues values for another look in the row, column and box of cell
+void ConstraintPropagator::touch(int cell, Sudoku::Mask values) {
+    const int r = cell / size, c = cell % size;
+    const int cellUnits[3] = {r, size + c, 2 * size + (r / boxSize) * boxSize + c / boxSize};
+    for (int u : cellUnits) {
+        if (!hiddenDirty[u]) hiddenQueue.push_back(u);
+        if (!reductionDirty[u]) reductionQueue.push_back(u);
+        hiddenDirty[u] |= values;
+        reductionDirty[u] |= values;
+    }
+}
+
+// A contradiction leaves work queued; the state is rolled back or reset
+// before the next call
+void ConstraintPropagator::clearPending() {
+    for (int u : hiddenQueue) hiddenDirty[u] = 0;
+    for (int u : reductionQueue) reductionDirty[u] = 0;
+    nakedQueue.clear();
+    hiddenQueue.clear();
+    reductionQueue.clear();
+}
+
+void ConstraintPropagator::setCandidates(int cell, Sudoku::Mask mask) {
+    const Sudoku::Mask removed = candidates[cell] & ~mask;
+    trail.push_back({cell, candidates[cell]});
+    candidates[cell] = mask;
+    touch(cell, removed);
+    if (mask && !(mask & (mask - 1))) nakedQueue.push_back(cell);
+}
+
+bool ConstraintPropagator::strikePeers(int cell, Sudoku::Mask bit) {
+    const int* cellPeers = &peers[cell * numPeers];
+    for (int k = 0; k < numPeers; ++k) {
+        int peer = cellPeers[k];
+        if (candidates[peer] & bit) {
+            setCandidates(peer, candidates[peer] & ~bit);
+            if (candidates[peer] == 0) return false;
+        }
+    }
+    return true;
+}
+
+bool ConstraintPropagator::place(Sudoku& sudoku, int cell, int val) {
+    sudoku.setValue(cell / size, cell % size, val);
+    filledCells.push_back(cell);
+    setCandidates(cell, 0);
+    return strikePeers(cell, Sudoku::Mask(1) << (val - 1));
+}
+
+bool ConstraintPropagator::eliminate(int cell, Sudoku::Mask bits) {
+    if (!(candidates[cell] & bits)) return true;
+    setCandidates(cell, candidates[cell] & ~bits);
+    return candidates[cell] != 0;
+}
+
+// Applies the rules to the queued work until none is left: naked singles
+// first, then hidden singles, and the costlier eliminations only once the
+// singles dry up
+bool ConstraintPropagator::drain(Sudoku& sudoku) {
+    while (true) {
+        if (!nakedQueue.empty()) {
+            const int cell = nakedQueue.back();
+            nakedQueue.pop_back();
+            if (sudoku.getValue(cell / size, cell % size) != 0) continue;
+            const Sudoku::Mask mask = candidates[cell];
+            if (mask == 0) return false;
+            if (!(mask & (mask - 1)) && !place(sudoku, cell, SudokuUtils::lowestValue(mask))) return false;
+        } else if (!hiddenQueue.empty()) {
+            const int u = hiddenQueue.back();
+            hiddenQueue.pop_back();
+            const Sudoku::Mask values = hiddenDirty[u];
+            hiddenDirty[u] = 0;
+            if (!hiddenSingles(sudoku, u, values)) return false;
+        } else if (!reductionQueue.empty()) {
+            const int u = reductionQueue.back();
+            reductionQueue.pop_back();
+            const Sudoku::Mask values = reductionDirty[u];
+            reductionDirty[u] = 0;
+            if (!(u >= 2 * size ? pointingPairs(u - 2 * size, values) : boxLineReduction(u, values)))
+                return false;
+        } else {
+            return true;
+        }
+    }
+}
+
+// Of values, one with a single possible cell in the unit must go there
+bool ConstraintPropagator::hiddenSingles(Sudoku& sudoku, int unit, Sudoku::Mask values) {
+    const int* cells = &units[unit * size];
+
+    Sudoku::Mask once = 0, twice = 0, placed = 0;
+    for (int k = 0; k < size; ++k) {
+        int val = sudoku.getValue(cells[k] / size, cells[k] % size);
+        if (val != 0) {
+            placed |= Sudoku::Mask(1) << (val - 1);
+        } else {
+            twice |= once & candidates[cells[k]];
+            once |= candidates[cells[k]];
+        }
+    }
+
+    Sudoku::Mask missing = values & ~placed;
+    if (missing & ~once) return false;   // some value has nowhere to go
+
+    Sudoku::Mask single = once & ~twice & missing;
+    if (!single) return true;
+
+    for (int k = 0; k < size; ++k) {
+        Sudoku::Mask hit = candidates[cells[k]] & single;
+        if (!hit) continue;
+        if (hit & (hit - 1)) return false;   // one cell, two forced values
+        if (!place(sudoku, cells[k], SudokuUtils::lowestValue(hit))) return false;
+    }
+    return true;
+}
+
+// Of values, one confined to one row (or column) inside the box is removed
+// from the rest of that row (or column)
+bool ConstraintPropagator::pointingPairs(int box, Sudoku::Mask values) {
+    const int* cells = &units[(2 * size + box) * size];
+
+    Sudoku::Mask present = 0;
+    for (int k = 0; k < size; ++k) present |= candidates[cells[k]];
+
+    for (Sudoku::Mask rest = present & values; rest; rest &= rest - 1) {
+        Sudoku::Mask bit = rest & (~rest + 1);
+        int row = -1, col = -1;
+        bool oneRow = true, oneCol = true;
+        for (int k = 0; k < size; ++k) {
+            if (!(candidates[cells[k]] & bit)) continue;
+            int r = cells[k] / size, c = cells[k] % size;
+            if (row < 0) { row = r; col = c; }
+            if (r != row) oneRow = false;
+            if (c != col) oneCol = false;
+        }
+
+        for (int k = 0; k < size; ++k) {
+            if (oneRow && k / boxSize != col / boxSize &&
+                !eliminate(row * size + k, bit)) return false;
+            if (oneCol && k / boxSize != row / boxSize &&
+                !eliminate(k * size + col, bit)) return false;
+        }
+    }
+    return true;
+}
+
+// Of values, one confined to one box inside the row (or column) is
+// removed from the rest of that box
+bool ConstraintPropagator::boxLineReduction(int line, Sudoku::Mask values) {
+    const int* cells = &units[line * size];
+    bool isRow = line < size;
+
+    Sudoku::Mask present = 0;
+    for (int k = 0; k < size; ++k) present |= candidates[cells[k]];
+
+    for (Sudoku::Mask rest = present & values; rest; rest &= rest - 1) {
+        Sudoku::Mask bit = rest & (~rest + 1);
+        int box = -1;
+        bool oneBox = true;
+        for (int k = 0; k < size; ++k) {
+            if (!(candidates[cells[k]] & bit)) continue;
+            int r = cells[k] / size, c = cells[k] % size;
+            int b = (r / boxSize) * boxSize + c / boxSize;
+            if (box < 0) box = b;
+            else if (b != box) oneBox = false;
+        }
+        if (!oneBox) continue;
+
+        const int* boxCells = &units[(2 * size + box) * size];
+        for (int k = 0; k < size; ++k) {
+            int r = boxCells[k] / size, c = boxCells[k] % size;
+            bool onLine = isRow ? r == line : c == line - size;
+            if (!onLine && !eliminate(boxCells[k], bit)) return false;
+        }
+    }
+    return true;
+}
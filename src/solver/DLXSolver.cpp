@@ -1,180 +1,168 @@
 //src/solver/DLXSolver.cpp
-#include <climits>
 #include "solver/DLXSolver.hpp"
+#include "core/SudokuUtils.hpp"
 #include <vector>
-#include <cstring>
 #include <iostream>
 #include <cmath>
+#include <map>
+#include <mutex>
 
 DLXSolver::DLXSolver()
-    : header(nullptr), nRows(0), nCols(0), size(9), boxSize(3) {}
-
-int DLXSolver::sudokuToIndex(int row, int col, int num) const {
-    // num starts from 1, so num-1
-    return (row * size + col) * size + (num - 1);
-}
-
-void DLXSolver::buildExactCoverMatrix(const Sudoku& sudoku) {
-    sudoku_ = sudoku;
-    size = sudoku.getSize();
-    boxSize = static_cast<int>(std::sqrt(size));
+    : size(9), boxSize(3) {}
+
+bool DLXSolver::buildExactCoverMatrix(DancingLinks& matrix, const Sudoku& board,
+                                      const std::vector<Sudoku::Mask>* candidates) {
+    if (!SudokuUtils::hasConsistentGivens(board)) return false;
+
+    const int size = board.getSize();
+    const int boxSize = board.getBoxSize();
+    const int cells = size * size;
+
+    // Constraint numbering of the full matrix: cell, row/digit, column/digit
+    // and box/digit blocks of size^2 columns each
+    auto cellConstraint = [=](int r, int c) { return r * size + c; };
+    auto rowConstraint = [=](int r, int num) { return cells + r * size + num - 1; };
+    auto colConstraint = [=](int c, int num) { return 2 * cells + c * size + num - 1; };
+    auto blockConstraint = [=](int r, int c, int num) {
+        int block = (r / boxSize) * boxSize + (c / boxSize);
+        return 3 * cells + block * size + num - 1;
+    };
 
-    nRows = size * size * size;    // size^3
-    nCols = 4 * size * size;       // 4 * size^2
-
-    columnNodes.clear();
-    columnNodes.resize(nCols);
-    nodes.clear();
-
-    // Initialize header node
-    header = new ColumnNode();
-    header->L = header->R = header->U = header->D = header;
-    header->size = 0;
-    header->name = "header";
-
-    // Setup columns circular linked list
-    ColumnNode* prev = header;
-    for (int i = 0; i < nCols; ++i) {
-        columnNodes[i].size = 0;
-        columnNodes[i].name = nullptr;
-        columnNodes[i].C = &columnNodes[i];
-        columnNodes[i].U = &columnNodes[i];
-        columnNodes[i].D = &columnNodes[i];
-        columnNodes[i].L = prev;
-        columnNodes[i].R = header;
-        prev->R = &columnNodes[i];
-        header->L = &columnNodes[i];
-        prev = &columnNodes[i];
+    std::size_t nRows = 0;
+    for (int cell = 0; cell < cells; ++cell)
+        nRows += SudokuUtils::countBits(candidates ? (*candidates)[cell]
+                                                   : board.getCandidates(cell / size, cell % size));
+
+    // Linking a row costs several times copying it, so unless pruning drops
+    // three rows in four, copying the full template and committing the
+    // givens is cheaper. The search over either matrix is the same.
+    const int allRows = cells * size;
+    if (!candidates && 4 * nRows > static_cast<std::size_t>(allRows)) {
+        matrix = *exactCoverTemplate(size);
+        for (int r = 0; r < size; ++r)
+            for (int c = 0; c < size; ++c) {
+                const int val = board.getValue(r, c);
+                if (val != 0) matrix.selectRow((r * size + c) * size + val - 1);
+            }
+        return true;
     }
 
-    nodes.reserve(nRows * 4);
+    // Givens satisfy four constraints each; the rest get dense numbers. The
+    // map is kept per thread, so repeated builds reuse its storage.
+    thread_local std::vector<int> column;
+    column.assign(4 * cells, 0);
+    for (int r = 0; r < size; ++r)
+        for (int c = 0; c < size; ++c) {
+            const int val = board.getValue(r, c);
+            if (val == 0) continue;
+            column[cellConstraint(r, c)] = column[rowConstraint(r, val)] =
+                column[colConstraint(c, val)] = column[blockConstraint(r, c, val)] = -1;
+        }
+    int nCols = 0;
+    for (int& col : column)
+        if (col == 0) col = nCols++;
 
-    // Helper lambdas for constraints
-    auto cellConstraint = [this](int r, int c) {
-        return r * size + c;
-    };
-    auto rowConstraint = [this](int r, int num) {
-        return size * size + r * size + num - 1;
-    };
-    auto colConstraint = [this](int c, int num) {
-        return 2 * size * size + c * size + num - 1;
-    };
-    auto blockConstraint = [this](int r, int c, int num) {
-        int block = (r / boxSize) * boxSize + (c / boxSize);
-        return 3 * size * size + block * size + num - 1;
-    };
+    matrix.init(nCols, nRows * 4, allRows);
 
     for (int r = 0; r < size; ++r) {
         for (int c = 0; c < size; ++c) {
-            int cellVal = sudoku.getValue(r, c);
-            for (int num = 1; num <= size; ++num) {
-                int rowIndex = sudokuToIndex(r, c, num);
-                if (cellVal != 0 && cellVal != num) continue;
-
+            if (board.getValue(r, c) != 0) continue;
+            Sudoku::Mask mask = candidates ? (*candidates)[r * size + c] : board.getCandidates(r, c);
+            for (; mask; mask &= mask - 1) {
+                const int num = SudokuUtils::lowestValue(mask);
                 int cols[4] = {
-                    cellConstraint(r, c),
-                    rowConstraint(r, num),
-                    colConstraint(c, num),
-                    blockConstraint(r, c, num)
+                    column[cellConstraint(r, c)],
+                    column[rowConstraint(r, num)],
+                    column[colConstraint(c, num)],
+                    column[blockConstraint(r, c, num)]
                 };
-
-                Node* rowNodes[4];
-                for (int i = 0; i < 4; ++i) {
-                    nodes.push_back(Node());
-                    Node* node = &nodes.back();
-                    node->rowID = rowIndex;
-                    node->colID = cols[i];
-                    node->C = &columnNodes[cols[i]];
-                    node->U = columnNodes[cols[i]].U;
-                    node->D = &columnNodes[cols[i]];
-                    columnNodes[cols[i]].U->D = node;
-                    columnNodes[cols[i]].U = node;
-                    columnNodes[cols[i]].size++;
-                    rowNodes[i] = node;
-                }
-
-                // link rowNodes circularly
-                for (int i = 0; i < 4; ++i) {
-                    rowNodes[i]->L = rowNodes[(i + 3) % 4];
-                    rowNodes[i]->R = rowNodes[(i + 1) % 4];
-                }
+                matrix.addRow((r * size + c) * size + (num - 1), cols, 4);
             }
         }
     }
+    return true;
 }
 
-void DLXSolver::cover(ColumnNode* c) {
-    c->R->L = c->L;
-    c->L->R = c->R;
-    for (Node* i = c->D; i != c; i = i->D) {
-        for (Node* j = i->R; j != i; j = j->R) {
-            j->D->U = j->U;
-            j->U->D = j->D;
-            static_cast<ColumnNode*>(j->C)->size--;  // Type conversion correction
-        }
+std::shared_ptr<const DancingLinks> DLXSolver::exactCoverTemplate(int size) {
+    static std::mutex cacheMutex;
+    static std::map<int, std::shared_ptr<const DancingLinks>> cache;
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto& entry = cache[size];
+    if (!entry) {
+        auto matrix = std::make_shared<DancingLinks>();
+        const Sudoku empty(size);
+        const std::vector<Sudoku::Mask> all(size * size, empty.getFullMask());
+        buildExactCoverMatrix(*matrix, empty, &all);
+        entry = std::move(matrix);
     }
+    return entry;
 }
 
-void DLXSolver::uncover(ColumnNode* c) {
-    for (Node* i = c->U; i != c; i = i->U) {
-        for (Node* j = i->L; j != i; j = j->L) {
-            static_cast<ColumnNode*>(j->C)->size++;  // Type conversion correction
-            j->D->U = j;
-            j->U->D = j;
-        }
-    }
-    c->R->L = c;
-    c->L->R = c;
+bool DLXSolver::setValueOrder(ValueOrder order, unsigned seed) {
+    valueOrder = order;
+    valueOrderSeed = seed;
+    return true;
 }
 
-bool DLXSolver::search(int k) {
-    if (header->R == header) return true;
-
-    ColumnNode* c = nullptr;
-    int minSize = INT_MAX;
-
-    for (ColumnNode* j = static_cast<ColumnNode*>(header->R); j != header; j = static_cast<ColumnNode*>(j->R)) {
-        if (j->size < minSize) {
-            minSize = j->size;
-            c = j;
-        }
+// Builds the matrix of the open cells, after propagation if enabled.
+// Fails when two givens clash or propagation finds a contradiction.
+bool DLXSolver::loadGivens(const Sudoku& sudoku) {
+    size = sudoku.getSize();
+    boxSize = static_cast<int>(std::sqrt(size));
+    restarts = 0;
+    spentNodes = 0;
+
+    start = sudoku;
+    bool built;
+    if (propagation) {
+        if (!propagator.propagate(start).consistent) return false;
+        built = buildExactCoverMatrix(matrix, start, &propagator.getCandidates());
+    } else {
+        built = buildExactCoverMatrix(matrix, start);
     }
-
-    if (c == nullptr || c->size == 0) return false;
-
-    cover(c);
-
-    for (Node* r = c->D; r != c; r = r->D) {
-        solution.push_back(r);
-
-        for (Node* j = r->R; j != r; j = j->R) {
-            cover(static_cast<ColumnNode*>(j->C));
-        }
-
-        if (search(k + 1)) return true;
-
-        for (Node* j = r->L; j != r; j = j->L) {
-            uncover(static_cast<ColumnNode*>(j->C));
-        }
-        solution.pop_back();
+    if (!built) return false;
+
+    // Set every time, so that switching back to Ascending (or to leftmost
+    // column ties after a restarted solve) takes effect on a matrix that
+    // is reused
+    std::vector<int> priority;
+    if (valueOrder == ValueOrder::Frequency) {
+        std::vector<int> givenCount(size + 1, 0);
+        for (int r = 0; r < size; ++r)
+            for (int c = 0; c < size; ++c) ++givenCount[sudoku.getValue(r, c)];
+        priority.resize(static_cast<std::size_t>(size) * size * size);
+        for (std::size_t rowID = 0; rowID < priority.size(); ++rowID)
+            priority[rowID] = givenCount[rowID % size + 1];
     }
-
-    uncover(c);
-    return false;
+    matrix.setRowOrder(valueOrder, std::move(priority), valueOrderSeed);
+    matrix.setRandomTieBreak(false);
+    return true;
 }
 
-
 bool DLXSolver::solve(Sudoku& sudoku) {
-    buildExactCoverMatrix(sudoku);
-    solution.clear();
-
-    bool solved = search(0);
+    if (!loadGivens(sudoku)) return false;
+
+    // A spent attempt unwinds completely, so the next one reuses the matrix
+    bool solved = restartPolicy.run([&](std::uint64_t budget, unsigned seed) {
+        spentNodes += matrix.getNodeCount();
+        matrix.setNodeBudget(budget);
+        matrix.setRandomTieBreak(restarts > 0, seed);
+        if (matrix.search(cancellationToken())) return RestartPolicy::Outcome::Solved;
+        return matrix.outOfBudget() ? RestartPolicy::Outcome::OutOfBudget
+                                    : RestartPolicy::Outcome::Exhausted;
+    }, restarts);
+    matrix.setNodeBudget(0);
     if (!solved) return false;
 
-    // parse solution backfill sudoku
-    for (auto node : solution) {
-        int rowID = node->rowID;
+    if (propagation) sudoku = start;
+    fillBoard(sudoku, matrix.getSolution());
+    return true;
+}
 
+// parse solution backfill sudoku
+void DLXSolver::fillBoard(Sudoku& sudoku, const std::vector<int>& rowIDs) const {
+    for (int rowID : rowIDs) {
         int num = rowID % size + 1;
         rowID /= size;
         int col = rowID % size;
@@ -182,14 +170,29 @@ bool DLXSolver::solve(Sudoku& sudoku) {
 
         sudoku.setValue(row, col, num);
     }
+}
 
-    delete header;
-    header = nullptr;
+// Every solution covers the same open cells, so one board is rewritten
+// in place for each of them
+std::uint64_t DLXSolver::enumerate(const Sudoku& sudoku, const SolutionCallback& onSolution) {
+    if (!loadGivens(sudoku)) return 0;
 
-    return true;
+    Sudoku board = start;
+    return matrix.enumerate([&](const std::vector<int>& rowIDs) {
+        fillBoard(board, rowIDs);
+        return onSolution(board);
+    }, cancellationToken());
+}
+
+std::uint64_t DLXSolver::countSolutions(const Sudoku& sudoku, std::uint64_t limit) {
+    if (limit == 0 || !loadGivens(sudoku)) return 0;
+
+    std::uint64_t found = 0;
+    matrix.enumerate([&](const std::vector<int>&) { return ++found < limit; }, cancellationToken());
+    return found;
 }
 DLXSolver::DLXSolver(int numThreads)
     : DLXSolver() // Call the default constructor to initialize
 {
     std::cout << "DLXSolver using " << numThreads << " threads.\n";
-}
\ No newline at end of file
+}
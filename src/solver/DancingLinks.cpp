@@ -0,0 +1,327 @@
+//src/solver/DancingLinks.cpp
+#include "solver/DancingLinks.hpp"
+#include <algorithm>
+
+void DancingLinks::init(int numColumns, std::size_t reserveNodes, int numRowIDs) {
+    nCols = numColumns;
+    const std::size_t headers = static_cast<std::size_t>(nCols) + 1;
+    for (auto* a : {&L, &R, &U, &D, &C, &rowOf}) {
+        a->clear();
+        a->reserve(headers + reserveNodes);
+        a->resize(headers);
+    }
+    S.assign(headers, 0);
+    rowNode.assign(numRowIDs, -1);
+
+    // Root and column headers form one horizontal ring
+    for (int i = 0; i <= nCols; ++i) {
+        L[i] = i - 1;
+        R[i] = i + 1;
+        U[i] = D[i] = C[i] = i;
+        rowOf[i] = -1;
+    }
+    L[0] = nCols;
+    R[nCols] = 0;
+    maxColumnRows = 0;
+    bucketsLive = false;
+
+    solution.clear();
+    nodeCount = 0;
+    rowOrder = ValueOrder::Ascending;
+    rowPriority.clear();
+}
+
+void DancingLinks::addRow(int rowID, const int* columns, int count) {
+    const int first = static_cast<int>(L.size());
+    if (rowID >= static_cast<int>(rowNode.size())) rowNode.resize(rowID + 1, -1);
+    rowNode[rowID] = first;
+    bucketsLive = false;
+
+    for (int k = 0; k < count; ++k) {
+        const int x = first + k;
+        const int c = columns[k] + 1;
+
+        L.push_back(k == 0 ? first + count - 1 : x - 1);
+        R.push_back(k == count - 1 ? first : x + 1);
+
+        // Vertical concatenation at the bottom of column c
+        U.push_back(U[c]);
+        D.push_back(c);
+        D[U[c]] = x;
+        U[c] = x;
+
+        C.push_back(c);
+        rowOf.push_back(rowID);
+        maxColumnRows = std::max(maxColumnRows, ++S[c]);
+    }
+}
+
+bool DancingLinks::selectRow(int rowID) {
+    const int x = getRowNode(rowID);
+    if (x < 0) return false;
+
+    // A row removed by an earlier cover is unlinked from at least one column
+    int j = x;
+    do {
+        if (D[U[j]] != j) return false;
+        j = R[j];
+    } while (j != x);
+
+    j = x;
+    do {
+        cover(C[j]);
+        j = R[j];
+    } while (j != x);
+    return true;
+}
+
+void DancingLinks::unselectRow(int rowID) {
+    const int x = getRowNode(rowID);
+    int j = L[x];
+    while (true) {
+        uncover(C[j]);
+        if (j == x) break;
+        j = L[j];
+    }
+}
+
+std::size_t DancingLinks::getMemoryBytes() const {
+    return (L.capacity() + R.capacity() + U.capacity() + D.capacity() +
+            C.capacity() + rowOf.capacity() + S.capacity() + rowNode.capacity() +
+            bucketCount.capacity()) * sizeof(std::int32_t) +
+           (bucketBits.capacity() + bucketSummary.capacity()) * sizeof(std::uint64_t);
+}
+
+void DancingLinks::buildBuckets() const {
+    const int maxSize = maxColumnRows;
+    bucketWords = nCols / 64 + 1;
+    summaryWords = (bucketWords + 63) / 64;
+    bucketBits.assign(static_cast<std::size_t>(maxSize + 1) * bucketWords, 0);
+    bucketSummary.assign(static_cast<std::size_t>(maxSize + 1) * summaryWords, 0);
+    bucketCount.assign(maxSize + 1, 0);
+    for (int j = R[0]; j != 0; j = R[j]) bucketInsert(j, S[j]);
+    bucketsLive = true;
+}
+
+inline void DancingLinks::bucketInsert(int c, int size) const {
+    const int word = c >> 6;
+    bucketBits[static_cast<std::size_t>(size) * bucketWords + word] |= std::uint64_t(1) << (c & 63);
+    bucketSummary[static_cast<std::size_t>(size) * summaryWords + (word >> 6)] |= std::uint64_t(1) << (word & 63);
+    ++bucketCount[size];
+}
+
+inline void DancingLinks::bucketErase(int c, int size) const {
+    const int word = c >> 6;
+    std::uint64_t& bits = bucketBits[static_cast<std::size_t>(size) * bucketWords + word];
+    bits &= ~(std::uint64_t(1) << (c & 63));
+    if (!bits)
+        bucketSummary[static_cast<std::size_t>(size) * summaryWords + (word >> 6)] &= ~(std::uint64_t(1) << (word & 63));
+    --bucketCount[size];
+}
+
+// Column at position rank (0-based, left to right) in the bucket of size
+int DancingLinks::bucketColumn(int size, int rank) const {
+    const std::uint64_t* summary = &bucketSummary[static_cast<std::size_t>(size) * summaryWords];
+    const std::uint64_t* bits = &bucketBits[static_cast<std::size_t>(size) * bucketWords];
+    for (int k = 0; k < summaryWords; ++k) {
+        for (std::uint64_t words = summary[k]; words; words &= words - 1) {
+            const int w = 64 * k + __builtin_ctzll(words);
+            std::uint64_t b = bits[w];
+            const int n = __builtin_popcountll(b);
+            if (rank >= n) {
+                rank -= n;
+                continue;
+            }
+            while (rank-- > 0) b &= b - 1;
+            return 64 * w + __builtin_ctzll(b);
+        }
+    }
+    return 0;
+}
+
+void DancingLinks::cover(int c) {
+    std::int32_t* const l = L.data();
+    std::int32_t* const r = R.data();
+    std::int32_t* const u = U.data();
+    std::int32_t* const d = D.data();
+
+    l[r[c]] = l[c];
+    r[l[c]] = r[c];
+    if (!bucketsLive) {
+        for (int i = d[c]; i != c; i = d[i]) {
+            for (int j = r[i]; j != i; j = r[j]) {
+                u[d[j]] = u[j];
+                d[u[j]] = d[j];
+                --S[C[j]];
+            }
+        }
+        return;
+    }
+
+    bucketErase(c, S[c]);
+    for (int i = d[c]; i != c; i = d[i]) {
+        for (int j = r[i]; j != i; j = r[j]) {
+            u[d[j]] = u[j];
+            d[u[j]] = d[j];
+            const int col = C[j];
+            bucketErase(col, S[col]);
+            bucketInsert(col, --S[col]);
+        }
+    }
+}
+
+void DancingLinks::uncover(int c) {
+    std::int32_t* const l = L.data();
+    std::int32_t* const r = R.data();
+    std::int32_t* const u = U.data();
+    std::int32_t* const d = D.data();
+
+    if (!bucketsLive) {
+        for (int i = u[c]; i != c; i = u[i]) {
+            for (int j = l[i]; j != i; j = l[j]) {
+                ++S[C[j]];
+                u[d[j]] = j;
+                d[u[j]] = j;
+            }
+        }
+    } else {
+        for (int i = u[c]; i != c; i = u[i]) {
+            for (int j = l[i]; j != i; j = l[j]) {
+                const int col = C[j];
+                bucketErase(col, S[col]);
+                bucketInsert(col, ++S[col]);
+                u[d[j]] = j;
+                d[u[j]] = j;
+            }
+        }
+        bucketInsert(c, S[c]);
+    }
+    l[r[c]] = c;
+    r[l[c]] = c;
+}
+
+int DancingLinks::chooseColumn() const {
+    // The header ring never changes order, so the leftmost column of a
+    // bucket is the one with the lowest index
+    if (!bucketsLive) buildBuckets();
+    for (int size = 0; size < static_cast<int>(bucketCount.size()); ++size)
+        if (bucketCount[size]) return bucketColumn(size, 0);
+    return 0;
+}
+
+void DancingLinks::setRandomTieBreak(bool enabled, unsigned seed) {
+    randomTieBreak = enabled;
+    tieBreak.seed(seed);
+}
+
+// chooseColumn with a uniform pick among the smallest columns
+int DancingLinks::chooseColumnRandomly() {
+    if (!bucketsLive) buildBuckets();
+    for (int size = 0; size < static_cast<int>(bucketCount.size()); ++size)
+        if (bucketCount[size]) return bucketColumn(size, static_cast<int>(tieBreak() % bucketCount[size]));
+    return 0;
+}
+
+void DancingLinks::getColumnRows(int column, std::vector<int>& rowIDs) const {
+    rowIDs.clear();
+    for (int i = D[column]; i != column; i = D[i]) rowIDs.push_back(rowOf[i]);
+}
+
+void DancingLinks::setRowOrder(ValueOrder order, std::vector<int> priority, unsigned seed) {
+    rowOrder = order;
+    rowPriority = std::move(priority);
+    rowShuffle.seed(seed);
+}
+
+bool DancingLinks::search(const CancellationToken* stop) {
+    solution.clear();
+    nodeCount = 0;
+    budgetSpent = false;
+    stopFlag = stop;
+    visitor = nullptr;
+    return searchLevel();
+}
+
+std::uint64_t DancingLinks::enumerate(const SolutionVisitor& onSolution, const CancellationToken* stop) {
+    solution.clear();
+    nodeCount = 0;
+    budgetSpent = false;
+    visited = 0;
+    stopFlag = stop;
+    visitor = &onSolution;
+    searchLevel();
+    visitor = nullptr;
+    return visited;
+}
+
+// Returns true to stop the search with the current rows covered
+bool DancingLinks::searchLevel() {
+    if (R[0] == 0) {
+        if (!visitor) return true;
+        ++visited;
+        return !(*visitor)(solution);
+    }
+    if (stopFlag && stopFlag->isCancelled()) return false;
+    if (nodeBudget && nodeCount >= nodeBudget) {
+        budgetSpent = true;
+        return false;
+    }
+
+    const int c = randomTieBreak ? chooseColumnRandomly() : chooseColumn();
+    if (S[c] == 0) return false;
+
+    cover(c);
+    if (rowOrder == ValueOrder::Ascending) {
+        for (int r = D[c]; r != c; r = D[r])
+            if (tryRow(r)) return true;
+    } else {
+        // Deeper levels never unlink rows from c, so the snapshot stays valid
+        const std::size_t begin = orderedRows.size();
+        orderColumnRows(c, begin);
+        for (std::size_t k = begin; k < orderedRows.size(); ++k) {
+            if (tryRow(orderedRows[k].second)) {
+                orderedRows.resize(begin);
+                return true;
+            }
+        }
+        orderedRows.resize(begin);
+    }
+    uncover(c);
+    return false;
+}
+
+// Selects the row of node r, searches below it and reverts it unless the
+// search stopped
+bool DancingLinks::tryRow(int r) {
+    ++nodeCount;
+    solution.push_back(rowOf[r]);
+    for (int j = R[r]; j != r; j = R[j]) cover(C[j]);
+
+    if (searchLevel()) return true;
+
+    for (int j = L[r]; j != r; j = L[j]) uncover(C[j]);
+    solution.pop_back();
+    return false;
+}
+
+// Appends the rows of the covered column c to orderedRows and sorts the
+// slice from begin by rowOrder, smallest score first
+void DancingLinks::orderColumnRows(int c, std::size_t begin) {
+    for (int r = D[c]; r != c; r = D[r]) {
+        int score = 0;
+        if (rowOrder == ValueOrder::LeastConstraining) {
+            for (int j = R[r]; j != r; j = R[j]) score += S[C[j]];
+        } else if (rowOrder == ValueOrder::Frequency) {
+            const int rowID = rowOf[r];
+            score = rowID < static_cast<int>(rowPriority.size()) ? -rowPriority[rowID] : 0;
+        }
+        orderedRows.emplace_back(score, r);
+    }
+
+    auto first = orderedRows.begin() + begin;
+    if (rowOrder == ValueOrder::Random)
+        std::shuffle(first, orderedRows.end(), rowShuffle);
+    else
+        std::stable_sort(first, orderedRows.end(),
+                         [](const auto& a, const auto& b) { return a.first < b.first; });
+}
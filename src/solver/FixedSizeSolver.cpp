@@ -0,0 +1,141 @@
+//src/solver/FixedSizeSolver.cpp
+#include "solver/FixedSizeSolver.hpp"
+#include "solver/BacktrackingSolver.hpp"
+#include "core/FixedSudoku.hpp"
+#include <iostream>
+
+namespace {
+
+// Iterative depth-first fill of the empty cells in row-major order.
+// remaining[d] holds the untried candidates of the cell at depth d.
+// Returns the number of solutions, stopping at limit or once stop is
+// cancelled; with limit 1 the board is left solved. nodes counts the
+// values placed. Values are tried smallest first unless orderer has
+// another order; then depth d sorts its candidates into the N-long slice
+// d of ordered when it is entered and walks it with cursor[d].
+template <int N>
+std::uint64_t fixedBacktrack(Fixed::Sudoku<N>& board, std::uint64_t limit, const CancellationToken* stop,
+                             std::uint64_t& nodes, ValueOrderer& orderer, int* ordered) {
+    using Geo = Fixed::Geometry<N>;
+    using Mask = typename Geo::Mask;
+
+    std::array<std::uint16_t, Geo::Cells> empties;
+    std::array<Mask, Geo::Cells> remaining;
+    std::array<int, Geo::Cells> cursor;
+    std::array<int, N + 1> givenCount{};
+    int count = 0;
+    for (int i = 0; i < Geo::Cells; ++i) {
+        if (board.value(i) == 0) empties[count++] = static_cast<std::uint16_t>(i);
+        ++givenCount[board.value(i)];
+    }
+    if (count == 0) return 1;
+    std::uint64_t found = 0;
+
+    const bool sorted = orderer.getOrder() != ValueOrder::Ascending;
+    auto orderDepth = [&](int depth) {
+        const int cell = empties[depth];
+        cursor[depth] = 0;
+        orderer.sort(remaining[depth], ordered + depth * N, [&](int val) {
+            if (orderer.getOrder() == ValueOrder::Frequency) return -givenCount[val];
+            int eliminated = 0;
+            for (int p : Geo::peers[cell])
+                if (board.value(p) == 0 && (board.candidates(p) & board.bitOf(val))) ++eliminated;
+            return eliminated;
+        });
+    };
+
+    int depth = 0;
+    remaining[0] = board.candidates(empties[0]);
+    if (sorted) orderDepth(0);
+    while (depth >= 0) {
+        if (stop && stop->isCancelled()) return found;
+        const int cell = empties[depth];
+        if (board.value(cell) != 0) board.clear(cell);
+
+        const Mask m = remaining[depth];
+        if (m == 0) {
+            --depth;
+            continue;
+        }
+        if (sorted) {
+            const int* values = ordered + depth * N;
+            while (!(m & board.bitOf(values[cursor[depth]]))) ++cursor[depth];
+            const int val = values[cursor[depth]++];
+            remaining[depth] = static_cast<Mask>(m ^ board.bitOf(val));
+            board.set(cell, val);
+        } else {
+            const Mask bit = static_cast<Mask>(m & (~m + 1));
+            remaining[depth] = static_cast<Mask>(m ^ bit);
+            board.set(cell, __builtin_ctzll(bit) + 1);
+        }
+        ++nodes;
+
+        // Forward check: an empty peer without candidates is a dead end
+        if (!board.peersAlive(cell)) continue;
+
+        if (depth + 1 == count) {
+            if (++found >= limit) return found;
+            continue;   // next value of the last cell
+        }
+        ++depth;
+        remaining[depth] = board.candidates(empties[depth]);
+        if (sorted) orderDepth(depth);
+    }
+    return found;
+}
+
+}
+
+bool FixedSizeSolver::setValueOrder(ValueOrder order, unsigned seed) {
+    valueOrderer = ValueOrderer(order, seed);
+    valueOrderSeed = seed;
+    return true;
+}
+
+bool FixedSizeSolver::solve(Sudoku& sudoku) {
+    nodeCount = 0;
+    bool solved = false;
+    bool handled = Fixed::dispatch(sudoku.getSize(), [&](auto n) {
+        constexpr int N = decltype(n)::value;
+        Fixed::Sudoku<N> board;
+        if (!board.load(sudoku)) return;
+        orderedValues.resize(Fixed::Geometry<N>::Cells * N);
+        solved = fixedBacktrack(board, 1, cancellationToken(), nodeCount,
+                                valueOrderer, orderedValues.data()) == 1;
+        if (solved) board.store(sudoku);
+    });
+    if (handled) return solved;
+
+    BacktrackingSolver fallback;
+    fallback.setValueOrder(valueOrderer.getOrder(), valueOrderSeed);
+    fallback.setCancellationToken(getCancellationToken());
+    solved = fallback.solve(sudoku);
+    nodeCount = fallback.getNodeCount();
+    return solved;
+}
+
+std::uint64_t FixedSizeSolver::countSolutions(const Sudoku& sudoku, std::uint64_t limit) {
+    nodeCount = 0;
+    if (limit == 0) return 0;
+    std::uint64_t found = 0;
+    bool handled = Fixed::dispatch(sudoku.getSize(), [&](auto n) {
+        constexpr int N = decltype(n)::value;
+        Fixed::Sudoku<N> board;
+        if (!board.load(sudoku)) return;
+        orderedValues.resize(Fixed::Geometry<N>::Cells * N);
+        found = fixedBacktrack(board, limit, cancellationToken(), nodeCount,
+                               valueOrderer, orderedValues.data());
+    });
+    if (handled) return found;
+
+    BacktrackingSolver fallback;
+    fallback.setValueOrder(valueOrderer.getOrder(), valueOrderSeed);
+    fallback.setCancellationToken(getCancellationToken());
+    found = fallback.countSolutions(sudoku, limit);
+    nodeCount = fallback.getNodeCount();
+    return found;
+}
+
+FixedSizeSolver::FixedSizeSolver(int numThreads) {
+    std::cout << "FixedSizeSolver using " << numThreads << " threads .\n";
+}
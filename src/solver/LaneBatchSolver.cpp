@@ -0,0 +1,273 @@
+//src/solver/LaneBatchSolver.cpp
+#include "solver/LaneBatchSolver.hpp"
+#include <iostream>
+#include <vector>
+
+namespace {
+
+constexpr int NumCells = 81;
+constexpr int NumUnits = 27;
+constexpr std::uint16_t AllDigits = 0x1FF;
+
+#if defined(__GNUC__) && !defined(__clang__)
+// Lane vectors never cross a call boundary: the round below is inlined into
+// each kernel entry point
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+// One vector per cell, lane k holding the candidate digits of puzzle k
+typedef std::uint16_t L16 __attribute__((vector_size(2 * LaneBatchSolver::LaneCount)));
+
+struct Lanes {
+    L16 cand[NumCells];
+};
+
+// All ones in the lanes where the condition holds
+struct LaneStatus {
+    L16 dead;    // a cell without candidates, a digit missing from a unit or a clash
+    L16 changed; // the round removed a candidate
+    L16 solved;  // every cell down to one candidate
+};
+
+// Cells of each row, column and box, and the three units of each cell
+struct Units {
+    int cells[NumUnits][9];
+    int of[NumCells][3];
+    Units() {
+        for (int i = 0; i < 9; ++i)
+            for (int j = 0; j < 9; ++j) {
+                cells[i][j] = 9 * i + j;
+                cells[9 + i][j] = 9 * j + i;
+                cells[18 + i][j] = 9 * (3 * (i / 3) + j / 3) + 3 * (i % 3) + j % 3;
+            }
+        for (int cell = 0; cell < NumCells; ++cell) {
+            const int r = cell / 9, c = cell % 9;
+            of[cell][0] = r;
+            of[cell][1] = 9 + c;
+            of[cell][2] = 18 + 3 * (r / 3) + c / 3;
+        }
+    }
+};
+const Units units;
+
+#define LANE_INLINE inline __attribute__((always_inline))
+
+LANE_INLINE L16 lanesWhere(L16 condition) {
+    return (L16)(condition != 0);
+}
+
+LANE_INLINE L16 singleLanes(L16 c) {
+    return (L16)((c & (c - 1)) == 0);
+}
+
+// One lockstep round for every lane: candidates seen as placed in a unit
+// leave its other cells, then a digit with one place left in a unit is
+// placed there
+LANE_INLINE void laneRound(Lanes& l, LaneStatus& status) {
+    const L16 all = L16{} + AllDigits;
+    L16 dead = {}, changed = {};
+
+    L16 single[NumCells];
+    for (int i = 0; i < NumCells; ++i) single[i] = l.cand[i] & singleLanes(l.cand[i]);
+
+    L16 placed[NumUnits];
+    for (int u = 0; u < NumUnits; ++u) {
+        L16 ones = {}, twos = {};
+        for (int cell : units.cells[u]) {
+            twos |= ones & single[cell];
+            ones |= single[cell];
+        }
+        placed[u] = ones;
+        dead |= twos;
+    }
+    for (int i = 0; i < NumCells; ++i) {
+        const int* u = units.of[i];
+        const L16 strike = placed[u[0]] | placed[u[1]] | placed[u[2]];
+        const L16 c = l.cand[i] & (~strike | single[i]);
+        changed |= c ^ l.cand[i];
+        l.cand[i] = c;
+    }
+
+    // Digits with exactly one place per unit, from bit-sliced counts
+    L16 once[NumUnits];
+    for (int u = 0; u < NumUnits; ++u) {
+        L16 ones = {}, twos = {};
+        for (int cell : units.cells[u]) {
+            twos |= ones & l.cand[cell];
+            ones |= l.cand[cell];
+        }
+        dead |= all & ~ones;
+        once[u] = ones & ~twos;
+    }
+    L16 solved = ~L16{};
+    for (int i = 0; i < NumCells; ++i) {
+        const int* u = units.of[i];
+        const L16 c = l.cand[i];
+        const L16 hidden = c & (once[u[0]] | once[u[1]] | once[u[2]]);
+        dead |= hidden & ~singleLanes(hidden);
+        const L16 next = c ^ ((c ^ hidden) & lanesWhere(hidden));
+        changed |= next ^ c;
+        dead |= ~lanesWhere(next);
+        solved &= singleLanes(next);
+        l.cand[i] = next;
+    }
+
+    status.dead = lanesWhere(dead);
+    status.changed = lanesWhere(changed);
+    status.solved = solved;
+}
+
+using RoundFn = void (*)(Lanes&, LaneStatus&);
+
+void roundPortable(Lanes& l, LaneStatus& status) {
+    laneRound(l, status);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+#define LANE_HAS_AVX2 1
+__attribute__((target("avx2"))) void roundAvx2(Lanes& l, LaneStatus& status) {
+    laneRound(l, status);
+}
+#endif
+
+void loadLane(Lanes& l, int lane, const Sudoku& board) {
+    for (int cell = 0; cell < NumCells; ++cell) {
+        const int val = board.getValue(cell / 9, cell % 9);
+        l.cand[cell][lane] = val >= 1 && val <= 9 ? std::uint16_t(1u << (val - 1)) : AllDigits;
+    }
+}
+
+// Writes the cells of a lane that are down to one candidate
+void storeLane(const Lanes& l, int lane, Sudoku& board) {
+    for (int cell = 0; cell < NumCells; ++cell) {
+        const unsigned c = l.cand[cell][lane];
+        if (c && !(c & (c - 1))) board.setValue(cell / 9, cell % 9, __builtin_ctz(c) + 1);
+    }
+}
+
+// Lane state saved at a guess, restored when the guess fails: NumCells
+// candidate masks per frame, pushed onto the lane's stack
+void saveLane(const Lanes& l, int lane, std::vector<std::uint16_t>& stack) {
+    const std::size_t frame = stack.size();
+    stack.resize(frame + NumCells);
+    for (int cell = 0; cell < NumCells; ++cell) stack[frame + cell] = l.cand[cell][lane];
+}
+
+void restoreLane(Lanes& l, int lane, std::vector<std::uint16_t>& stack) {
+    const std::size_t frame = stack.size() - NumCells;
+    for (int cell = 0; cell < NumCells; ++cell) l.cand[cell][lane] = stack[frame + cell];
+    stack.resize(frame);
+}
+
+// Open cell of a lane with the fewest candidates
+int branchCell(const Lanes& l, int lane) {
+    int best = -1, fewest = 10;
+    for (int cell = 0; cell < NumCells; ++cell) {
+        const int n = __builtin_popcount(l.cand[cell][lane]);
+        if (n > 1 && n < fewest) {
+            best = cell;
+            fewest = n;
+            if (n == 2) break;
+        }
+    }
+    return best;
+}
+
+}
+
+LaneBatchSolver::LaneBatchSolver(int numThreads, BitboardSolver::Kernel kernel)
+    : kernel(kernel != BitboardSolver::Kernel::Portable
+                     && BitboardSolver::isKernelSupported(BitboardSolver::Kernel::Avx2)
+                 ? BitboardSolver::Kernel::Avx2
+                 : BitboardSolver::Kernel::Portable),
+      fallback(1) {
+    std::cout << "LaneBatchSolver using " << numThreads << " threads .\n";
+}
+
+void LaneBatchSolver::solveBatchChunk(Sudoku* const* boards, std::size_t count, std::uint8_t* solved) {
+    stats = {};
+    for (std::size_t i = 0; i < count; ++i) solved[i] = 0;
+
+#ifdef LANE_HAS_AVX2
+    const RoundFn round = kernel == BitboardSolver::Kernel::Avx2 ? roundAvx2 : roundPortable;
+#else
+    const RoundFn round = roundPortable;
+#endif
+
+    Lanes lanes = {};
+    std::size_t owner[LaneCount];
+    for (auto& stack : saved) stack.clear();
+    std::size_t next = 0;
+    int active = 0;
+
+    // Gives a lane the next 9x9 board of the chunk; boards of other sizes
+    // are solved on the spot by the fallback. Idle lanes are all zero,
+    // which reads as dead and is ignored.
+    auto refill = [&](int lane) {
+        while (next < count) {
+            const std::size_t i = next++;
+            if (boards[i]->getSize() != 9) {
+                solved[i] = fallback.solve(*boards[i]);
+                ++stats.fallbacks;
+                continue;
+            }
+            loadLane(lanes, lane, *boards[i]);
+            owner[lane] = i;
+            ++active;
+            return;
+        }
+        owner[lane] = count;
+        for (L16& c : lanes.cand) c[lane] = 0;
+    };
+    for (int lane = 0; lane < LaneCount; ++lane) refill(lane);
+
+    while (active > 0 && !isCancelled()) {
+        LaneStatus status;
+        round(lanes, status);
+        ++stats.rounds;
+
+        for (int lane = 0; lane < LaneCount; ++lane) {
+            const std::size_t i = owner[lane];
+            if (i == count) continue;
+            if (status.dead[lane]) {
+                if (!saved[lane].empty()) {
+                    restoreLane(lanes, lane, saved[lane]);
+                    continue;
+                }
+                ++stats.rejectedInLanes;
+            } else if (status.changed[lane]) {
+                continue;
+            } else if (status.solved[lane]) {
+                // A round without changes has also checked the last
+                // placements for clashes
+                storeLane(lanes, lane, *boards[i]);
+                solved[i] = 1;
+                ++stats.solvedInLanes;
+            } else {
+                // Stalled: guess the lowest digit, keeping the others
+                const int cell = branchCell(lanes, lane);
+                const std::uint16_t c = lanes.cand[cell][lane];
+                const std::uint16_t first = c & -c;
+                saveLane(lanes, lane, saved[lane]);
+                saved[lane][saved[lane].size() - NumCells + cell] = c & ~first;
+                lanes.cand[cell][lane] = first;
+                ++stats.guesses;
+                continue;
+            }
+            saved[lane].clear();
+            --active;
+            refill(lane);
+        }
+    }
+}
+
+bool LaneBatchSolver::solve(Sudoku& sudoku) {
+    Sudoku* board = &sudoku;
+    std::uint8_t solved = 0;
+    solveBatchChunk(&board, 1, &solved);
+    return solved != 0;
+}
+
+std::uint64_t LaneBatchSolver::countSolutions(const Sudoku& sudoku, std::uint64_t limit) {
+    return fallback.countSolutions(sudoku, limit);
+}
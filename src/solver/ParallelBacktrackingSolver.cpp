@@ -1,97 +1,103 @@
 //src/solver/ParallelBacktrackingSolver.cpp
 #include "solver/ParallelBacktrackingSolver.hpp"
-#include <mutex>
-
-ParallelBacktrackingSolver::ParallelBacktrackingSolver(int numThreads)
-    : numThreads_(numThreads) {
+#include "solver/BacktrackingSolver.hpp"
+#include "solver/SolutionStream.hpp"
+#include "solver/SearchStack.hpp"
+#include "core/SudokuUtils.hpp"
+
+ParallelBacktrackingSolver::ParallelBacktrackingSolver(int numThreads, std::shared_ptr<SolverSession> session)
+    : numThreads_(numThreads),
+      session_(session ? std::move(session) : SolverSession::shared(numThreads)) {
         std::cout << "ParallelBacktrackingSolver using " << numThreads << " threads .\n";
     }
 
-bool ParallelBacktrackingSolver::solve(Sudoku& sudoku) {
-    auto emptyCells = sudoku.getEmptyCells();
-
-    tf::Taskflow taskflow;
-    tf::Executor executor(numThreads_);
-
-    std::atomic<bool> solved(false);
-
-    std::mutex mtx; // Protect the Sudoku instance
-    Sudoku sudokuCopy = sudoku; // Avoid direct manipulation of the original chessboard
-
-    std::function<void(size_t, Sudoku&)> backtrack = [&](size_t index, Sudoku& board) {
-        if (solved.load()) return;
-        if (index == emptyCells.size()) {
-            std::lock_guard<std::mutex> lock(mtx);
-            sudoku = board; // Copy the result back to the original disk
-            solved.store(true);
-            return;
-        }
-
-        auto [row, col] = emptyCells[index];
-        for (int val = 1; val <= board.getSize(); ++val) {
-            if (solved.load()) return;
-
-            if (board.isValid(row, col, val)) {
-                board.setValue(row, col, val);
-                backtrack(index + 1, board);
-                board.setValue(row, col, 0);
-            }
-        }
-    };
+std::unique_ptr<SolverBase> ParallelBacktrackingSolver::clone() const {
+    auto copy = std::make_unique<ParallelBacktrackingSolver>(numThreads_, session_);
+    copy->setCancellationToken(getCancellationToken());
+    copy->setValueOrder(valueOrder, valueOrderSeed);
+    return copy;
+}
 
-    // Parallelize the first layer of branches and create multiple tasks
-    for (int val = 1; val <= sudokuCopy.getSize(); ++val) {
-        if (sudokuCopy.isValid(emptyCells[0].first, emptyCells[0].second, val)) {
-            Sudoku boardCopy = sudokuCopy;
-            boardCopy.setValue(emptyCells[0].first, emptyCells[0].second, val);
+bool ParallelBacktrackingSolver::setValueOrder(ValueOrder order, unsigned seed) {
+    valueOrder = order;
+    valueOrderSeed = seed;
+    if (sequential) sequential->setValueOrder(order, seed);
+    return true;
+}
 
-            taskflow.emplace([boardCopy, &backtrack, &emptyCells]() mutable {
-                backtrack(1, boardCopy);
-            });
-        }
+void ParallelBacktrackingSolver::solveBatchChunk(Sudoku* const* boards, std::size_t count, std::uint8_t* solved) {
+    if (!sequential) {
+        sequential = std::make_unique<BacktrackingSolver>(1);
+        sequential->setValueOrder(valueOrder, valueOrderSeed);
     }
+    sequential->setCancellationToken(getCancellationToken());
+    for (std::size_t i = 0; i < count; ++i) solved[i] = sequential->solve(*boards[i]);
+}
 
-    executor.run(taskflow).wait();
-
-    return solved.load();
+// Idle workers take over the untried values of busy ones
+bool ParallelBacktrackingSolver::solve(Sudoku& sudoku) {
+    return parallelStackSolve(session_->getExecutor(), sudoku, [this]() { return isCancelled(); },
+                              ValueOrderer(valueOrder, valueOrderSeed));
 }
 
-bool ParallelBacktrackingSolver::solveAll(Sudoku& sudoku, std::vector<Sudoku>& allSolutions) {
+std::uint64_t ParallelBacktrackingSolver::enumerate(const Sudoku& sudoku, const SolutionCallback& onSolution) {
+    if (!SudokuUtils::hasConsistentGivens(sudoku)) return 0;
     auto emptyCells = sudoku.getEmptyCells();
 
     tf::Taskflow taskflow;
-    tf::Executor executor(numThreads_);
-
-    std::mutex mtx;
-
-    for (int val = 1; val <= sudoku.getSize(); ++val) {
-        if (sudoku.isValid(emptyCells[0].first, emptyCells[0].second, val)) {
-            Sudoku boardCopy = sudoku;
-            boardCopy.setValue(emptyCells[0].first, emptyCells[0].second, val);
+    tf::Executor& executor = session_->getExecutor();
+
+    // Expand the top of the tree until every worker has plenty of boards;
+    // subtrees differ wildly in size
+    std::vector<Sudoku> frontier{sudoku};
+    size_t depth = 0;
+    while (depth < emptyCells.size() && !frontier.empty() &&
+           frontier.size() < 16 * executor.num_workers()) {
+        auto [row, col] = emptyCells[depth];
+        std::vector<Sudoku> next;
+        for (const Sudoku& board : frontier) {
+            for (int val = 1; val <= board.getSize(); ++val) {
+                if (board.isValid(row, col, val)) {
+                    next.push_back(board);
+                    next.back().setValue(row, col, val);
+                }
+            }
+        }
+        frontier = std::move(next);
+        ++depth;
+    }
 
-            taskflow.emplace([boardCopy, &emptyCells, &allSolutions, &mtx]() mutable {
-                std::function<void(size_t, Sudoku&)> backtrackAll;
-                backtrackAll = [&](size_t index, Sudoku& board) {
-                    if (index == emptyCells.size()) {
-                        std::lock_guard<std::mutex> lock(mtx);
-                        allSolutions.push_back(board);
-                        return;
-                    }
-                    auto [row, col] = emptyCells[index];
-                    for (int v = 1; v <= board.getSize(); ++v) {
-                        if (board.isValid(row, col, v)) {
-                            board.setValue(row, col, v);
-                            backtrackAll(index + 1, board);
-                            board.setValue(row, col, 0);
-                        }
-                    }
-                };
-                backtrackAll(1, boardCopy);
-            });
+    if (depth == emptyCells.size()) {
+        std::uint64_t delivered = 0;
+        for (const Sudoku& board : frontier) {
+            ++delivered;
+            if (!onSolution(board)) break;
         }
+        return delivered;
     }
 
-    executor.run(taskflow).wait();
+    SolutionStream stream;
+    const std::atomic<bool>& stopped = stream.stopFlag();
+
+    SearchStack prototype(sudoku, ValueOrderer(valueOrder, valueOrderSeed));
+    for (Sudoku& board : frontier) {
+        taskflow.emplace([&, depth]() {
+            SolutionStream::Writer writer(stream);
+            SearchStack stack = prototype;
+            auto [row, col] = emptyCells[depth];
+            SearchStack::Branch branch{board, static_cast<int>(depth), board.getCandidates(row, col)};
+            stack.run(branch, [&](const Sudoku& solution) { return !writer.push(solution); },
+                      [&]() { return stopped.load(std::memory_order_relaxed) || isCancelled(); });
+        });
+    }
+
+    auto done = executor.run(taskflow, [&stream]() { stream.close(); });
+    std::uint64_t delivered = stream.consume(onSolution);
+    done.wait();
+    return delivered;
+}
 
-    return !allSolutions.empty();
+std::uint64_t ParallelBacktrackingSolver::countSolutions(const Sudoku& sudoku, std::uint64_t limit) {
+    return parallelStackCount(session_->getExecutor(), sudoku, limit, [this]() { return isCancelled(); },
+                              ValueOrderer(valueOrder, valueOrderSeed));
 }
@@ -1,57 +1,43 @@
 //src/solver/ParallelBruteForceSolver.cpp
 #include "solver/ParallelBruteForceSolver.hpp"
-#include <mutex>
+#include "solver/BruteForceSolver.hpp"
+#include "solver/SearchStack.hpp"
 
-ParallelBruteForceSolver::ParallelBruteForceSolver(int numThreads)
-    : numThreads_(numThreads) {
+ParallelBruteForceSolver::ParallelBruteForceSolver(int numThreads, std::shared_ptr<SolverSession> session)
+    : numThreads_(numThreads),
+      session_(session ? std::move(session) : SolverSession::shared(numThreads)) {
         std::cout << "ParallelBruteForceSolver using " << numThreads << " threads .\n";
     }
 
-bool ParallelBruteForceSolver::solve(Sudoku& sudoku) {
-    auto emptyCells = sudoku.getEmptyCells();
-    if (emptyCells.empty()) return true;
-
-    tf::Taskflow taskflow;
-    tf::Executor executor(numThreads_);
-
-    std::atomic<bool> solved(false);
-    std::mutex mtx;  // Protect sudoku
-
-    auto size = sudoku.getSize();
-
-    std::function<bool(Sudoku&, size_t)> bruteForce = [&](Sudoku& board, size_t index) {
-        if (solved.load()) return true;
-        if (index == emptyCells.size()) return true;
-
-        auto [row, col] = emptyCells[index];
-        for (int val = 1; val <= size; ++val) {
-            if (solved.load()) return true;
-            if (board.isValid(row, col, val)) {
-                board.setValue(row, col, val);
-                if (bruteForce(board, index + 1)) return true;
-                board.setValue(row, col, 0);
-            }
-        }
-        return false;
-    };
+std::unique_ptr<SolverBase> ParallelBruteForceSolver::clone() const {
+    auto copy = std::make_unique<ParallelBruteForceSolver>(numThreads_, session_);
+    copy->setCancellationToken(getCancellationToken());
+    copy->setValueOrder(valueOrder, valueOrderSeed);
+    return copy;
+}
 
-    for (int val = 1; val <= size; ++val) {
-        if (sudoku.isValid(emptyCells[0].first, emptyCells[0].second, val)) {
-            Sudoku boardCopy = sudoku;
-            boardCopy.setValue(emptyCells[0].first, emptyCells[0].second, val);
+bool ParallelBruteForceSolver::setValueOrder(ValueOrder order, unsigned seed) {
+    valueOrder = order;
+    valueOrderSeed = seed;
+    if (sequential) sequential->setValueOrder(order, seed);
+    return true;
+}
 
-            taskflow.emplace([&sudoku, &bruteForce, &solved, &mtx, boardCopy]() mutable {
-                if (bruteForce(boardCopy, 1)) {
-                    if (!solved.exchange(true)) { // The first task to find a solution is executed
-                        std::lock_guard<std::mutex> lock(mtx);
-                        sudoku = boardCopy; //Copy the solution back to the passed parameter
-                    }
-                }
-            });
-        }
+void ParallelBruteForceSolver::solveBatchChunk(Sudoku* const* boards, std::size_t count, std::uint8_t* solved) {
+    if (!sequential) {
+        sequential = std::make_unique<BruteForceSolver>(1);
+        sequential->setValueOrder(valueOrder, valueOrderSeed);
     }
+    sequential->setCancellationToken(getCancellationToken());
+    for (std::size_t i = 0; i < count; ++i) solved[i] = sequential->solve(*boards[i]);
+}
 
-    executor.run(taskflow).wait();
+bool ParallelBruteForceSolver::solve(Sudoku& sudoku) {
+    return parallelStackSolve(session_->getExecutor(), sudoku, [this]() { return isCancelled(); },
+                              ValueOrderer(valueOrder, valueOrderSeed));
+}
 
-    return solved.load();
+std::uint64_t ParallelBruteForceSolver::countSolutions(const Sudoku& sudoku, std::uint64_t limit) {
+    return parallelStackCount(session_->getExecutor(), sudoku, limit, [this]() { return isCancelled(); },
+                              ValueOrderer(valueOrder, valueOrderSeed));
 }
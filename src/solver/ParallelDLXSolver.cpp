@@ -1,11 +1,14 @@
 // src/solver/ParallelDLXSolver.cpp
 #include "solver/ParallelDLXSolver.hpp"
+#include "solver/DLXSolver.hpp"
 #include <iostream>
 #include <atomic>
-#include <array>
+#include <algorithm>
+#include <condition_variable>
 
-ParallelDLXSolver::ParallelDLXSolver(int numThreads)
-    : numThreads_(numThreads > 0 ? numThreads : std::thread::hardware_concurrency()) {
+ParallelDLXSolver::ParallelDLXSolver(int numThreads, std::shared_ptr<SolverSession> session)
+    : numThreads_(numThreads > 0 ? numThreads : std::thread::hardware_concurrency()),
+      session_(session ? std::move(session) : SolverSession::shared(numThreads_)) {
     // Debug prints out the number of execution threads
     static bool printed = false;
     if (!printed) {
@@ -16,386 +19,333 @@ ParallelDLXSolver::ParallelDLXSolver(int numThreads)
 }
 
 std::unique_ptr<SolverBase> ParallelDLXSolver::clone() const {
-    return std::make_unique<ParallelDLXSolver>(numThreads_);
+    auto copy = std::make_unique<ParallelDLXSolver>(numThreads_, session_);
+    copy->setSplitLimits(splitLimits);
+    copy->setCancellationToken(getCancellationToken());
+    return copy;
+}
+
+void ParallelDLXSolver::solveBatchChunk(Sudoku* const* boards, std::size_t count, std::uint8_t* solved) {
+    if (!sequential) sequential = std::make_unique<DLXSolver>();
+    sequential->setCancellationToken(getCancellationToken());
+    for (std::size_t i = 0; i < count; ++i) solved[i] = sequential->solve(*boards[i]);
 }
 
 bool ParallelDLXSolver::solve(Sudoku& sudoku) {
-    buildExactCoverMatrix(sudoku);
-    //std::cout << "[Debug] Matrix built. Starting DLX search..." << std::endl;
+    if (!loadGivens(sudoku)) return false;
 
-    bool success = parallelSearch(0);
+    bool success = parallelSearch(1) == 1;
 
     if (success) {
-        //std::cout << "[Debug] Solution found." << std::endl;
         extractSolutionToSudoku(sudoku);
-    } else {
-        //std::cout << "[Debug] No solution found." << std::endl;
     }
     return success;
 }
 
+// Workers share one counter and all stop once it reaches limit
+std::uint64_t ParallelDLXSolver::countSolutions(const Sudoku& sudoku, std::uint64_t limit) {
+    if (limit == 0 || !loadGivens(sudoku)) return 0;
+    return parallelSearch(limit);
+}
 
-
-void ParallelDLXSolver::buildExactCoverMatrix(const Sudoku& sudoku) {
+// The matrix holds only the open cells' candidate rows, so every task
+// inherits the givens without replaying them
+bool ParallelDLXSolver::loadGivens(const Sudoku& sudoku) {
     N = sudoku.getSize();            // 9, 16, 25 ...
-    boxSize = static_cast<int>(std::sqrt(N));
-    int N2 = N * N;
-    nCols = 4 * N2;
+    solutionRows.clear();
+    return DLXSolver::buildExactCoverMatrix(matrix, sudoku);
+}
 
-    header = new ColumnNode("header");
+void ParallelDLXSolver::extractSolutionToSudoku(Sudoku& sudoku) {
+    fillBoard(sudoku, solutionRows.data(), solutionRows.size());
+}
 
-    columnNodes.resize(nCols);
-    for (int i = 0; i < nCols; ++i) {
-        columnNodes[i] = ColumnNode("C" + std::to_string(i));
-        columnNodes[i].up = columnNodes[i].down = &columnNodes[i];
-        columnNodes[i].column = &columnNodes[i];
+void ParallelDLXSolver::fillBoard(Sudoku& sudoku, const int* rowIDs, std::size_t count) const {
+    for (std::size_t i = 0; i < count; ++i) {
+        int idx = rowIDs[i];
+        int row = idx / (N * N);
+        int col = (idx % (N * N)) / N;
+        int num = idx % N;
+        sudoku.setValue(row, col, num + 1);
     }
+}
 
-    header->right = &columnNodes[0];
-    header->left = &columnNodes[nCols - 1];
-    columnNodes[0].left = header;
-    columnNodes[nCols - 1].right = header;
+struct ParallelDLXSolver::SearchState {
+    tf::Executor& executor;
+    int numWorkers;
+    std::uint64_t limit;                  // solutions wanted
+    std::atomic<std::uint64_t> count{0};  // solutions found so far
+    CancellationToken done;               // limit reached or cancelled from outside
+    std::atomic<int> queued{0};   // spawned but not started yet
+    std::atomic<int> active{0};   // currently running
+
+    SearchState(tf::Executor& executor, std::uint64_t limit, const CancellationToken* outer)
+        : executor(executor), numWorkers(static_cast<int>(executor.num_workers())), limit(limit),
+          done(outer) {}
+};
+
+// Returns the number of solutions found, at most limit. The first one
+// found is kept in solutionRows.
+std::uint64_t ParallelDLXSolver::parallelSearch(std::uint64_t limit) {
+    tf::Executor& executor = session_->getExecutor();
+    tf::Taskflow taskflow;
+    SearchState state(executor, limit, cancellationToken());
 
-    for (int i = 1; i < nCols; ++i) {
-        columnNodes[i].left = &columnNodes[i - 1];
-        columnNodes[i - 1].right = &columnNodes[i];
-    }
+    // No task of an earlier search is left to read the old prefixes
+    workers.resize(state.numWorkers);
+    for (WorkerScratch& scratch : workers) scratch.prefixes.reset();
 
-    auto addRow = [&](int row, int col, int num) {
-        int base = (row * N + col) * N + num;
-        std::array<int, 4> cols = {
-            row * N + num,                                 // Row constraint
-            N2 + col * N + num,                            // Column constraint
-            2 * N2 + (row / boxSize * boxSize + col / boxSize) * N + num, // Block constraint
-            3 * N2 + row * N + col                         // Cell constraint
-        };
-
-        std::vector<Node*> rowNodes(4);
-        for (int i = 0; i < 4; ++i) {
-            int cIdx = cols[i];
-            ColumnNode* colNode = &columnNodes[cIdx];
-
-            nodes.emplace_back();  // Using deque will not cause the indicator to become invalid
-            Node* node = &nodes.back();
-            rowNodes[i] = node;
-
-            node->column = colNode;
-            node->rowID = base;
-
-            // Vertical concatenation
-            node->down = colNode;
-            node->up = colNode->up;
-            colNode->up->down = node;
-            colNode->up = node;
-
-            colNode->size++;
-        }
+    state.queued.store(1);
+    taskflow.emplace([this, &state](tf::Subflow& subflow) {
+        searchTask(subflow, Prefix{}, state);
+    });
 
-        // horizontal concatenation
-        for (int i = 0; i < 4; ++i) {
-            rowNodes[i]->left = rowNodes[(i + 3) % 4];
-            rowNodes[i]->right = rowNodes[(i + 1) % 4];
-        }
+    executor.run(taskflow).wait();
 
-        rowInfos.push_back({row, col, num});
-    };
-
-    for (int row = 0; row < N; ++row) {
-        for (int col = 0; col < N; ++col) {
-            int val = sudoku.getValue(row, col);
-            if (val != 0) {
-                addRow(row, col, val - 1);
-            } else {
-                for (int num = 0; num < N; ++num) {
-                    addRow(row, col, num);
-                }
-            }
-        }
-    }
-    //std::cout << "[Debug] Total ColumnNodes: " << columnNodes.size() << "\n";
-    //std::cout << "[Debug] Total Data Nodes: " << nodes.size() << "\n";
-    //std::cout << "[Debug] Total Matrix Rows (rowInfos): " << rowInfos.size() << "\n";
+    return std::min(state.count.load(), limit);
 }
 
-
-
-void ParallelDLXSolver::cover(ColumnNode* c) {
-    //std::cout << "[Debug] Cover column: " << c->name << std::endl;
-    c->right->left = c->left;
-    c->left->right = c->right;
-    for (Node* i = c->down; i != c; i = i->down) {
-        for (Node* j = i->right; j != i; j = j->right) {
-            j->down->up = j->up;
-            j->up->down = j->down;
-            j->column->size--;
-        }
-    }
+// Spawns the task for scratch.path, copied into the spawning worker's arena
+void ParallelDLXSolver::spawnTask(tf::Subflow& subflow, WorkerScratch& scratch, SearchState& state) {
+    const Prefix prefix{scratch.prefixes.copy(scratch.path.data(), scratch.path.size()),
+                        static_cast<int>(scratch.path.size())};
+    state.queued.fetch_add(1);
+    subflow.emplace([this, prefix, &state](tf::Subflow& child) {
+        searchTask(child, prefix, state);
+    });
 }
 
-void ParallelDLXSolver::uncover(ColumnNode* c) {
-    for (Node* i = c->up; i != c; i = i->up) {
-        for (Node* j = i->left; j != i; j = j->left) {
-            j->column->size++;
-            j->down->up = j;
-            j->up->down = j;
-        }
+// Rebuilds the node reached by prefix (rows committed below the givens)
+// and either splits its smallest column into subtasks or searches it here.
+// Subtasks only start once this returns, so the worker's scratch is free
+// for them afterwards.
+void ParallelDLXSolver::searchTask(tf::Subflow& subflow, Prefix prefix, SearchState& state) {
+    state.queued.fetch_sub(1);
+    if (state.done.isCancelled()) return;
+
+    state.active.fetch_add(1);
+    struct ActiveGuard {
+        std::atomic<int>& active;
+        ~ActiveGuard() { active.fetch_sub(1); }
+    } guard{state.active};
+
+    // Flat copy of the base matrix, then replay the prefix in O(1) per row
+    WorkerScratch& scratch = workers[state.executor.this_worker_id()];
+    DancingLinks& local = scratch.matrix;
+    std::vector<int>& path = scratch.path;
+    std::vector<int>& rows = scratch.rows;
+    local = matrix;
+    path.assign(prefix.rows, prefix.rows + prefix.length);
+    for (int rowID : path) local.selectRow(rowID);
+
+    int col = local.chooseColumn();
+    if (col == 0) {
+        rows.clear();
+        recordSolution(path, rows, state);
+        return;
     }
-    c->right->left = c;
-    c->left->right = c;
-}
-
-bool ParallelDLXSolver::search(int k, std::vector<Node*>& localSolution) {
-    //std::cout << "[Debug] Entering search with depth = " << k << "\n";
-
-    if (header->right == header) return true;
-
-    ColumnNode* c = nullptr;
-    int minSize = INT32_MAX;
-
-    // Choose column with fewest 1s (heuristic)
-    for (ColumnNode* j = static_cast<ColumnNode*>(header->right); j != header; j = static_cast<ColumnNode*>(j->right)) {
-        if (j->size < minSize) {
-            minSize = j->size;
-            c = j;
+    if (local.getColumnSize(col) == 0) return;
+
+    local.getColumnRows(col, rows);
+
+    const SplitLimits& limits = splitLimits;
+    const bool shallow = prefix.length < limits.maxDepth;
+    const int idle = std::max(1, state.numWorkers - state.active.load());
+    if (shallow && static_cast<int>(rows.size()) >= limits.minColumnSize &&
+        state.queued.load() < idle * limits.tasksPerWorker) {
+        for (int rowID : rows) {
+            path.push_back(rowID);
+            spawnTask(subflow, scratch, state);
+            path.pop_back();
         }
+        return;
     }
 
-    if (!c) return false;
-
-    cover(c);
+    for (size_t i = 0; i < rows.size(); ++i) {
+        if (state.done.isCancelled()) return;
 
-    for (Node* r = c->down; r != c; r = r->down) {
-        localSolution.push_back(r);
-
-        // Cover all columns in row r, and record them for uncovering later
-        std::vector<ColumnNode*> coveredCols;
-        for (Node* j = r->right; j != r; j = j->right) {
-            cover(j->column);
-            coveredCols.push_back(j->column);
-        }
-
-        if (search(k + 1, localSolution)) {
-            uncover(c);
-            return true;
-        }
-
-        // Uncover in reverse order
-        for (auto it = coveredCols.rbegin(); it != coveredCols.rend(); ++it) {
-            uncover(*it);
+        // A worker ran dry: hand the untried branches over and stop here
+        if (shallow && rows.size() - i >= 2 && state.queued.load() == 0 &&
+            state.active.load() < state.numWorkers) {
+            for (size_t j = i; j < rows.size(); ++j) {
+                path.push_back(rows[j]);
+                spawnTask(subflow, scratch, state);
+                path.pop_back();
+            }
+            return;
         }
 
-        localSolution.pop_back();
+        local.selectRow(rows[i]);
+        path.push_back(rows[i]);
+        // Two captures keep the visitor in std::function's inline buffer
+        const std::pair<std::vector<int>*, SearchState*> sink{&path, &state};
+        local.enumerate([this, &sink](const std::vector<int>& rest) {
+            recordSolution(*sink.first, rest, *sink.second);
+            return !sink.second->done.isCancelled();
+        }, &state.done);
+        if (state.done.isCancelled()) return;
+        path.pop_back();
+        local.unselectRow(rows[i]);
     }
-
-    uncover(c);
-    return false;
 }
 
-
-
-void ParallelDLXSolver::extractSolutionToSudoku(Sudoku& sudoku) {
-    //std::cout << "[Debug] Extracting solution. Size: " << solutionRows.size() << std::endl;
-    for (const auto& info : solutionRows) {
-        sudoku.setValue(info.row, info.col, info.num + 1);
+void ParallelDLXSolver::recordSolution(const std::vector<int>& prefix, const std::vector<int>& rest,
+                                       SearchState& state) {
+    std::uint64_t n = state.count.fetch_add(1) + 1;
+    if (n > state.limit) return;
+    if (n == 1) {
+        std::lock_guard<std::mutex> lock(solutionMutex);
+        solutionRows.assign(prefix.begin(), prefix.end());
+        solutionRows.insert(solutionRows.end(), rest.begin(), rest.end());
     }
+    if (n == state.limit) state.done.cancel();
 }
 
+// One slice of the search tree for enumerate: the rows below the givens
+// leading to it and, flat, the remaining rows of the solutions found
+// under it that the consumer has not taken yet
+struct ParallelDLXSolver::EnumerationTask {
+    std::vector<int> prefix;
+    std::vector<int> rows;
+    std::uint64_t solutions = 0;
+    bool finished = false;
+};
+
+// Workers claim slices in order and enumerate each into its own sink on
+// their own matrix, handing solutions over in chunks. The calling thread
+// drains the sinks strictly in slice order, which is the sequential search
+// order. A sink holding sinkCapacity solutions blocks its worker; slices
+// are started in order, so the one being drained is always running.
+std::uint64_t ParallelDLXSolver::enumerate(const Sudoku& sudoku, const SolutionCallback& onSolution) {
+    constexpr std::uint64_t chunkSize = 64;
+    constexpr std::uint64_t sinkCapacity = 1024;
+
+    if (!loadGivens(sudoku)) return 0;
+
+    tf::Executor& executor = session_->getExecutor();
+    const std::size_t numWorkers = executor.num_workers();
+    workers.resize(numWorkers);
+
+    std::vector<EnumerationTask> tasks;
+    for (auto& prefix : splitFrontier(splitLimits.tasksPerWorker * numWorkers)) {
+        tasks.emplace_back();
+        tasks.back().prefix = std::move(prefix);
+    }
 
-int ParallelDLXSolver::sudokuToIndex(int row, int col, int num) const {
-    return (row * N + col) * N + num;
-}
-
-bool ParallelDLXSolver::parallelSearch(int k) {
-    //std::cout << "[Debug] Entering parallelSearch(k=" << k << ")" << std::endl;
+    std::mutex mutex;
+    std::condition_variable changed;
+    CancellationToken stop(cancellationToken());
+    std::atomic<std::size_t> next{0};
 
-    // whether it has answer
-    std::atomic<bool> found{false};
-    tf::Executor executor(numThreads_);
     tf::Taskflow taskflow;
+    for (std::size_t w = 0; w < std::min(numWorkers, tasks.size()); ++w) {
+        taskflow.emplace([this, w, &tasks, &mutex, &changed, &stop, &next]() {
+            DancingLinks& local = workers[w].matrix;
+            std::vector<int> chunk;
+            std::uint64_t chunkSolutions = 0;
+
+            for (std::size_t i; (i = next.fetch_add(1)) < tasks.size();) {
+                EnumerationTask& task = tasks[i];
+                auto handOver = [&]() {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    changed.wait(lock, [&] { return task.solutions < sinkCapacity || stop.isCancelled(); });
+                    task.rows.insert(task.rows.end(), chunk.begin(), chunk.end());
+                    task.solutions += chunkSolutions;
+                    chunk.clear();
+                    chunkSolutions = 0;
+                    changed.notify_all();
+                    return !stop.isCancelled();
+                };
+
+                if (!stop.isCancelled()) {
+                    local = matrix;
+                    for (int rowID : task.prefix) local.selectRow(rowID);
+                    local.enumerate([&](const std::vector<int>& rest) {
+                        chunk.insert(chunk.end(), rest.begin(), rest.end());
+                        return ++chunkSolutions < chunkSize || handOver();
+                    }, &stop);
+                    if (chunkSolutions) handOver();
+                }
 
-    // Check if all columns are covered, indicating that the solution has been found
-    if (header->right == header) {
-        //std::cout << "[Debug] All columns covered. Solution found!" << std::endl;
-        return true;
-    }
-
-    // Select columns with at least 1 node
-    ColumnNode* col = nullptr;
-    int minSize = INT32_MAX;
-    for (ColumnNode* c = static_cast<ColumnNode*>(header->right); c != header; c = static_cast<ColumnNode*>(c->right)) {
-        //std::cout << "[Debug] Checking column " << c->name << " with size " << c->size << std::endl;
-        if (c->size < minSize) {
-            minSize = c->size;
-            col = c;
-        }
-    }
-
-    if (col == nullptr) {
-        //std::cout << "[Debug] No column selected. Exiting." << std::endl;
-        return false;
+                std::lock_guard<std::mutex> lock(mutex);
+                task.finished = true;
+                changed.notify_all();
+            }
+        });
     }
-    //std::cout << "[Debug] Selected column with minSize=" << minSize << " (" << col->name << ")" << std::endl;
+    auto done = executor.run(taskflow);
+
+    std::uint64_t delivered = 0;
+    Sudoku board = sudoku;
+    for (EnumerationTask& task : tasks) {
+        fillBoard(board, task.prefix.data(), task.prefix.size());
+
+        bool last = false;
+        while (!last && !stop.isCancelled()) {
+            std::vector<int> rows;
+            std::uint64_t count;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [&task] { return task.solutions > 0 || task.finished; });
+                rows.swap(task.rows);
+                count = task.solutions;
+                task.solutions = 0;
+                last = task.finished;
+                changed.notify_all();
+            }
 
-    if (col->down == col) {
-        //std::cout << "[Debug] No rows under selected column. Dead end." << std::endl;
-        return false;
-    }
-    
-    // First collect all row nodes of the column
-    std::vector<Node*> candidateRows;
-    int countRows = 0;
-    for (Node* row = col->down; row != col; row = row->down) {
-        //std::cout << "[Debug] Found row node at ptr " << row << ", rowID = " << row->rowID << std::endl;
-        //std::cout << "[Debug] Found row node with rowID = " << row->rowID << std::endl;
-        candidateRows.push_back(row);
-        countRows++;
-    }
-    //std::cout << "[Debug] Total rows under selected column: " << countRows << std::endl;
-
-    // cover then column
-    cover(col);
-    //std::cout << "[Debug] Column " << col->name << " covered." << std::endl;
-
-    // Creating parallel tasks
-    int task_id = 0;
-    for (Node* row : candidateRows) {
-        int rowID = row->rowID;
-        //std::cout << "[Debug] Creating Task " << task_id++ << " for rowID: " << rowID << std::endl;
-        taskflow.emplace([this, rowID, &found]() {
-            if (found.load()) return;
-
-            ParallelDLXSolver localSolver;
-            localSolver.cloneFrom(*this);
-
-            std::vector<Node*> localSolution;
-            if (localSolver.searchFromRowID(rowID, localSolution)) {
-                found.store(true);
-                std::lock_guard<std::mutex> lock(solutionMutex);
-                solutionRows.clear();
-                for (Node* n : localSolution) {
-                    int idx = n->rowID;
-                    int row = idx / (N * N);
-                    int col = (idx % (N * N)) / N;
-                    int num = idx % N;
-                    solutionRows.push_back({row, col, num});
+            const std::size_t stride = count ? rows.size() / count : 0;
+            for (std::uint64_t s = 0; s < count; ++s) {
+                fillBoard(board, rows.data() + s * stride, stride);
+                ++delivered;
+                if (!onSolution(board)) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    stop.cancel();
+                    changed.notify_all();
+                    break;
                 }
             }
-        });
+        }
+        if (stop.isCancelled()) break;
     }
 
-    //std::cout << "[Debug] All tasks added. Running executor..." << std::endl;
-
-    executor.run(taskflow).wait();
-
-    uncover(col);
-    //std::cout << "[Debug] Column " << col->name << " uncovered." << std::endl;
-
-    //std::cout << "[Debug] Exiting parallelSearch(k=" << k << "), found: " << found.load() << std::endl;
-    return found.load();
+    done.wait();
+    return delivered;
 }
 
-void ParallelDLXSolver::cloneFrom(const ParallelDLXSolver& other) {
-    N = other.N;                 
-    boxSize = other.boxSize;     
-    nCols = other.nCols;
-    nRows = other.nRows;
-    rowInfos = other.rowInfos;
-
-    columnNodes.clear();
-    nodes.clear();
-    columnNodes.resize(nCols);
-
-    // Initialize ColumnNodes. The name can be omitted if not necessary.
-    for (int i = 0; i < nCols; ++i) {
-        columnNodes[i] = ColumnNode(); 
-        columnNodes[i].up = columnNodes[i].down = &columnNodes[i];
-        columnNodes[i].column = &columnNodes[i];
-    }
-
-    // Connect columnNodes into a horizontal ring chain
-    header = new ColumnNode();
-    header->left = &columnNodes[nCols - 1];
-    header->right = &columnNodes[0];
-    columnNodes[0].left = header;
-    columnNodes[nCols - 1].right = header;
-    for (int i = 1; i < nCols; ++i) {
-        columnNodes[i].left = &columnNodes[i - 1];
-        columnNodes[i - 1].right = &columnNodes[i];
-    }
-
-    // Add Row node
-    for (const auto& info : rowInfos) {
-        const int base = sudokuToIndex(info.row, info.col, info.num);
-        const int N2 = N * N;
-        const std::array<int, 4> cols = {
-            info.row * N + info.num,                                    // row constraint
-            N2 + info.col * N + info.num,                               // col constraint
-            2 * N2 + (info.row / boxSize * boxSize + info.col / boxSize) * N + info.num, // box constraint
-            3 * N2 + info.row * N + info.col                            // cell constraint
-        };
-
-        std::array<Node*, 4> rowNodes;
-        for (int i = 0; i < 4; ++i) {
-            ColumnNode* colNode = &columnNodes[cols[i]];
-            nodes.emplace_back();
-            Node* node = &nodes.back();
-            rowNodes[i] = node;
-
-            node->column = colNode;
-            node->rowID = base;
-
-           // Vertical concatenation
-            node->down = colNode;
-            node->up = colNode->up;
-            colNode->up->down = node;
-            colNode->up = node;
-
-            colNode->size++;
-        }
-
-        // Horizontally concatenate four nodes
-        for (int i = 0; i < 4; ++i) {
-            rowNodes[i]->left = rowNodes[(i + 3) % 4];
-            rowNodes[i]->right = rowNodes[(i + 1) % 4];
-        }
+// Prefixes of rows below the givens that partition the search tree, in
+// the order the sequential search visits them. The tree is cut at the
+// shallowest depth giving at least target slices.
+std::vector<std::vector<int>> ParallelDLXSolver::splitFrontier(std::size_t target) {
+    DancingLinks& scratch = workers.front().matrix;
+    scratch = matrix;
+
+    std::vector<std::vector<int>> prefixes{{}};
+    std::vector<int> prefix;
+    for (int depth = 1; depth <= splitLimits.maxDepth && prefixes.size() < target; ++depth) {
+        std::vector<std::vector<int>> deeper;
+        collectPrefixes(scratch, prefix, depth, deeper);
+        if (deeper.size() <= prefixes.size()) break;   // only solved or dead slices left
+        prefixes = std::move(deeper);
     }
+    return prefixes;
 }
 
-bool ParallelDLXSolver::searchFromRowID(int rowID, std::vector<Node*>& outSolution) {
-    // Find the Node* corresponding to row
-    Node* targetRow = nullptr;
-    for (Node& node : nodes) {
-        if (node.rowID == rowID) {
-            targetRow = &node;
-            break;
-        }
-    }
-
-    if (!targetRow) return false;
-
-    outSolution.push_back(targetRow);
-
-    // First cover the column of the row
-    ColumnNode* mainCol = targetRow->column;
-    cover(mainCol);
-
-    // Cover all related columns of this column
-    std::vector<ColumnNode*> covered;
-    for (Node* j = targetRow->right; j != targetRow; j = j->right) {
-        cover(j->column);
-        covered.push_back(j->column);
-    }
-
-    // Enter the next level recursively
-    if (search(1, outSolution)) {
-        return true;
+void ParallelDLXSolver::collectPrefixes(DancingLinks& scratch, std::vector<int>& prefix, int depth,
+                                        std::vector<std::vector<int>>& prefixes) {
+    int col = scratch.chooseColumn();
+    if (depth == 0 || col == 0) {
+        prefixes.push_back(prefix);
+        return;
     }
 
-    // If unsuccessful, return status
-    for (auto it = covered.rbegin(); it != covered.rend(); ++it) {
-        uncover(*it);
+    std::vector<int> rows;
+    scratch.getColumnRows(col, rows);
+    for (int rowID : rows) {
+        scratch.selectRow(rowID);
+        prefix.push_back(rowID);
+        collectPrefixes(scratch, prefix, depth - 1, prefixes);
+        prefix.pop_back();
+        scratch.unselectRow(rowID);
     }
-    uncover(mainCol);
-    outSolution.pop_back();
-    return false;
 }
@@ -0,0 +1,91 @@
+//src/solver/PortfolioSolver.cpp
+#include "solver/PortfolioSolver.hpp"
+#include <iostream>
+
+PortfolioSolver::PortfolioSolver(int numThreads) {
+    std::cout << "PortfolioSolver using " << numThreads << " threads .\n";
+}
+
+void PortfolioSolver::addEngine(const std::string& name, std::unique_ptr<SolverBase> engine) {
+    engines.push_back({name, std::move(engine)});
+}
+
+// Goes around the announcing constructor, so that the clones of a batch
+// stay quiet
+std::unique_ptr<SolverBase> PortfolioSolver::clone() const {
+    std::unique_ptr<PortfolioSolver> copy(new PortfolioSolver(Quiet{}));
+    for (const Engine& engine : engines) copy->addEngine(engine.name, engine.solver->clone());
+    copy->setCancellationToken(getCancellationToken());
+    return copy;
+}
+
+int PortfolioSolver::race(const std::function<bool(std::size_t, const CancellationToken&)>& attempt) {
+    lastWinner.clear();
+    if (engines.empty()) return -1;
+    if (!racers || racers->getNumThreads() < static_cast<int>(engines.size()))
+        racers = std::make_shared<SolverSession>(static_cast<int>(engines.size()));
+
+    // Cancelled by the winner, or together with the portfolio's own token
+    auto race = std::make_shared<CancellationToken>(cancellationToken());
+    std::atomic<int> winner{-1};
+
+    tf::Taskflow taskflow;
+    for (std::size_t i = 0; i < engines.size(); ++i) {
+        engines[i].solver->setCancellationToken(race);
+        taskflow.emplace([i, &attempt, &winner, &race]() {
+            if (!attempt(i, *race)) return;
+
+            int none = -1;
+            if (winner.compare_exchange_strong(none, static_cast<int>(i))) race->cancel();
+        });
+    }
+    racers->getExecutor().run(taskflow).wait();
+
+    for (Engine& engine : engines) engine.solver->setCancellationToken(getCancellationToken());
+
+    int first = winner.load();
+    if (first >= 0) lastWinner = engines[first].name;
+    return first;
+}
+
+bool PortfolioSolver::solve(Sudoku& sudoku) {
+    std::vector<Sudoku> boards(engines.size(), sudoku);
+    std::vector<std::uint8_t> solved(engines.size(), 0);
+    int first = race([&](std::size_t i, const CancellationToken& race) {
+        solved[i] = engines[i].solver->solve(boards[i]);
+        // A false after cancellation only means the engine gave up
+        return solved[i] || !race.isCancelled();
+    });
+
+    if (first < 0 || !solved[first]) return false;
+    sudoku = boards[first];
+    return true;
+}
+
+std::uint64_t PortfolioSolver::countSolutions(const Sudoku& sudoku, std::uint64_t limit) {
+    if (limit == 0) return 0;
+    std::vector<std::uint64_t> counts(engines.size(), 0);
+    int first = race([&](std::size_t i, const CancellationToken& race) {
+        counts[i] = engines[i].solver->countSolutions(sudoku, limit);
+        // A count cut short by cancellation proves nothing
+        return counts[i] != CountUnsupported && !race.isCancelled();
+    });
+
+    if (first >= 0) return counts[first];
+    return isCancelled() ? 0 : CountUnsupported;
+}
+
+// Solutions must reach onSolution in order from one engine, so there is
+// no race: each engine enumerates in turn until one delivers
+std::uint64_t PortfolioSolver::enumerate(const Sudoku& sudoku, const SolutionCallback& onSolution) {
+    lastWinner.clear();
+    for (Engine& engine : engines) {
+        if (isCancelled()) break;
+        std::uint64_t delivered = engine.solver->enumerate(sudoku, onSolution);
+        if (delivered > 0) {
+            lastWinner = engine.name;
+            return delivered;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,59 @@
+//src/solver/PropagatingSolver.cpp
+#include "solver/PropagatingSolver.hpp"
+
+PropagatingSolver::PropagatingSolver(std::unique_ptr<SolverBase> inner)
+    : inner(std::move(inner)) {}
+
+bool PropagatingSolver::solve(Sudoku& sudoku) {
+    Sudoku reduced = sudoku;
+    lastResult = propagator.propagate(reduced);
+    solvedWithoutSearch = lastResult.consistent && reduced.isComplete();
+    if (!lastResult.consistent) return false;
+
+    if (!solvedWithoutSearch && !inner->solve(reduced)) return false;
+    sudoku = reduced;
+    return true;
+}
+
+// Every deduction holds in all solutions, so the reduced board has exactly
+// the solutions of the original one
+std::uint64_t PropagatingSolver::enumerate(const Sudoku& sudoku, const SolutionCallback& onSolution) {
+    Sudoku reduced = sudoku;
+    lastResult = propagator.propagate(reduced);
+    solvedWithoutSearch = lastResult.consistent && reduced.isComplete();
+    if (!lastResult.consistent) return 0;
+
+    if (solvedWithoutSearch) {
+        onSolution(reduced);
+        return 1;
+    }
+    return inner->enumerate(reduced, onSolution);
+}
+
+std::uint64_t PropagatingSolver::countSolutions(const Sudoku& sudoku, std::uint64_t limit) {
+    if (limit == 0) return 0;
+    Sudoku reduced = sudoku;
+    lastResult = propagator.propagate(reduced);
+    solvedWithoutSearch = lastResult.consistent && reduced.isComplete();
+    if (!lastResult.consistent) return 0;
+    if (solvedWithoutSearch) return 1;
+    return inner->countSolutions(reduced, limit);
+}
+
+// Boards are reduced in place; one the wrapped solver then fails on keeps
+// the deduced cells
+void PropagatingSolver::solveBatchChunk(Sudoku* const* boards, std::size_t count, std::uint8_t* solved) {
+    searchBoards.clear();
+    for (std::size_t i = 0; i < count; ++i) {
+        PropagationResult result = propagator.propagate(*boards[i]);
+        solved[i] = result.consistent && boards[i]->isComplete();
+        if (!result.consistent) propagator.rollback(*boards[i], {});
+        else if (!solved[i]) searchBoards.push_back(boards[i]);
+    }
+    if (searchBoards.empty()) return;
+
+    searchSolved.resize(searchBoards.size());
+    SolverBase::solveBatchChunk(*inner, searchBoards.data(), searchBoards.size(), searchSolved.data());
+    for (std::size_t i = 0, k = 0; i < count && k < searchBoards.size(); ++i)
+        if (boards[i] == searchBoards[k]) solved[i] = searchSolved[k++];
+}
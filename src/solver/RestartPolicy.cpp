@@ -0,0 +1,37 @@
+//src/solver/RestartPolicy.cpp
+#include "solver/RestartPolicy.hpp"
+#include <cmath>
+
+std::uint64_t RestartPolicy::luby(int attempt) {
+    // Find the complete block 2^k - 1 holding attempt + 1, then recurse
+    // into its first half until attempt + 1 closes a block
+    std::uint64_t i = static_cast<std::uint64_t>(attempt) + 1;
+    while (true) {
+        int k = 1;
+        while (((std::uint64_t(1) << k) - 1) < i) ++k;
+        if (i == (std::uint64_t(1) << k) - 1) return std::uint64_t(1) << (k - 1);
+        i -= (std::uint64_t(1) << (k - 1)) - 1;
+    }
+}
+
+std::uint64_t RestartPolicy::budget(int attempt) const {
+    switch (schedule) {
+        case Schedule::Luby:
+            return baseNodes * luby(attempt);
+        case Schedule::Geometric: {
+            // Past 2^62 nodes the attempt is as good as unlimited
+            double nodes = static_cast<double>(baseNodes) * std::pow(growth, attempt);
+            return nodes >= 4.6e18 ? std::uint64_t(1) << 62 : static_cast<std::uint64_t>(nodes);
+        }
+        default:
+            return 0;
+    }
+}
+
+bool parseRestartSchedule(const std::string& name, RestartPolicy::Schedule& schedule) {
+    if (name == "none") schedule = RestartPolicy::Schedule::None;
+    else if (name == "luby") schedule = RestartPolicy::Schedule::Luby;
+    else if (name == "geometric") schedule = RestartPolicy::Schedule::Geometric;
+    else return false;
+    return true;
+}
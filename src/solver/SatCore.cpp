@@ -0,0 +1,340 @@
+//src/solver/SatCore.cpp
+#include "solver/SatCore.hpp"
+#include "solver/RestartPolicy.hpp"
+#include <algorithm>
+
+namespace {
+
+constexpr std::uint64_t restartUnit = 100;   // conflicts per Luby step
+constexpr double varDecay = 0.95;
+constexpr double clauseDecay = 0.999;
+
+}
+
+int SatCore::newVar() {
+    int var = static_cast<int>(assigns.size());
+    assigns.push_back(-1);
+    polarity.push_back(0);
+    level.push_back(0);
+    reason.push_back(-1);
+    activity.push_back(0.0);
+    heapIndex.push_back(-1);
+    seen.push_back(0);
+    watches.emplace_back();
+    watches.emplace_back();
+    heapInsert(var);
+    return var;
+}
+
+bool SatCore::addClause(std::vector<Lit> lits) {
+    if (!ok) return false;
+    cancelUntil(0);
+
+    // Drop duplicates and literals false at the top level; a tautology or
+    // a literal already true makes the clause redundant
+    std::sort(lits.begin(), lits.end());
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < lits.size(); ++i) {
+        Lit l = lits[i];
+        if (litValue(l) == 1 || (kept > 0 && lits[kept - 1] == (l ^ 1))) return true;
+        if (litValue(l) == 0 || (kept > 0 && lits[kept - 1] == l)) continue;
+        lits[kept++] = l;
+    }
+    lits.resize(kept);
+
+    if (lits.empty()) return ok = false;
+    if (lits.size() == 1) {
+        enqueue(lits[0], -1);
+        return ok = propagate() < 0;
+    }
+    attachClause(std::move(lits), false);
+    ++numOriginal;
+    return true;
+}
+
+int SatCore::attachClause(std::vector<Lit> lits, bool isLearnt) {
+    int index = static_cast<int>(clauses.size());
+    watches[lits[0]].push_back({index, lits[1]});
+    watches[lits[1]].push_back({index, lits[0]});
+    clauses.emplace_back();
+    clauses.back().lits = std::move(lits);
+    clauses.back().learnt = isLearnt;
+    return index;
+}
+
+void SatCore::enqueue(Lit l, int from) {
+    int var = l >> 1;
+    assigns[var] = static_cast<std::int8_t>((l & 1) ^ 1);
+    level[var] = decisionLevel();
+    reason[var] = from;
+    trail.push_back(l);
+}
+
+// Returns the index of a falsified clause, or -1
+int SatCore::propagate() {
+    while (qhead < trail.size()) {
+        const Lit falseLit = trail[qhead++] ^ 1;
+        std::vector<Watcher>& ws = watches[falseLit];
+        ++propagations;
+
+        std::size_t i = 0, j = 0;
+        while (i < ws.size()) {
+            Watcher w = ws[i++];
+            if (litValue(w.blocker) == 1) {
+                ws[j++] = w;
+                continue;
+            }
+            Clause& clause = clauses[w.clause];
+            if (clause.deleted) continue;   // drop the stale watcher
+
+            std::vector<Lit>& lits = clause.lits;
+            if (lits[0] == falseLit) std::swap(lits[0], lits[1]);
+            const Lit first = lits[0];
+            const Watcher kept{w.clause, first};
+            if (first != w.blocker && litValue(first) == 1) {
+                ws[j++] = kept;
+                continue;
+            }
+
+            // Move the watch to another literal that is not false
+            bool moved = false;
+            for (std::size_t k = 2; k < lits.size(); ++k) {
+                if (litValue(lits[k]) != 0) {
+                    std::swap(lits[1], lits[k]);
+                    watches[lits[1]].push_back(kept);
+                    moved = true;
+                    break;
+                }
+            }
+            if (moved) continue;
+
+            ws[j++] = kept;
+            if (litValue(first) == 0) {
+                while (i < ws.size()) ws[j++] = ws[i++];
+                ws.resize(j);
+                qhead = trail.size();
+                return w.clause;
+            }
+            enqueue(first, w.clause);
+        }
+        ws.resize(j);
+    }
+    return -1;
+}
+
+// First-UIP learning: resolves the conflict with the reasons of the
+// current level until one literal of that level is left. The learnt
+// clause ends up in `learnt`, asserting literal first.
+void SatCore::analyze(int conflict, int& backtrackLevel) {
+    learnt.assign(1, 0);
+    int pathCount = 0;
+    Lit p = -1;
+    std::size_t index = trail.size();
+
+    do {
+        Clause& clause = clauses[conflict];
+        if (clause.learnt) bumpClause(clause);
+
+        for (std::size_t k = (p == -1 ? 0 : 1); k < clause.lits.size(); ++k) {
+            Lit q = clause.lits[k];
+            int var = q >> 1;
+            if (seen[var] || level[var] == 0) continue;
+            bumpVar(var);
+            seen[var] = 1;
+            if (level[var] >= decisionLevel()) ++pathCount;
+            else learnt.push_back(q);
+        }
+
+        while (!seen[trail[--index] >> 1]) {}
+        p = trail[index];
+        conflict = reason[p >> 1];
+        seen[p >> 1] = 0;
+        --pathCount;
+    } while (pathCount > 0);
+    learnt[0] = p ^ 1;
+
+    // Drop literals implied by the rest of the clause
+    toClear.assign(learnt.begin(), learnt.end());
+    std::size_t kept = 1;
+    for (std::size_t i = 1; i < learnt.size(); ++i)
+        if (!redundant(learnt[i])) learnt[kept++] = learnt[i];
+    learnt.resize(kept);
+    for (Lit l : toClear) seen[l >> 1] = 0;
+
+    backtrackLevel = 0;
+    if (learnt.size() > 1) {
+        std::size_t maxIndex = 1;
+        for (std::size_t i = 2; i < learnt.size(); ++i)
+            if (level[learnt[i] >> 1] > level[learnt[maxIndex] >> 1]) maxIndex = i;
+        std::swap(learnt[1], learnt[maxIndex]);
+        backtrackLevel = level[learnt[1] >> 1];
+    }
+}
+
+// Whether every other literal of l's reason is already in the clause
+bool SatCore::redundant(Lit l) const {
+    int from = reason[l >> 1];
+    if (from < 0) return false;
+    const std::vector<Lit>& lits = clauses[from].lits;
+    for (std::size_t k = 1; k < lits.size(); ++k) {
+        int var = lits[k] >> 1;
+        if (!seen[var] && level[var] > 0) return false;
+    }
+    return true;
+}
+
+void SatCore::cancelUntil(int target) {
+    if (decisionLevel() <= target) return;
+    for (std::size_t i = trail.size(); i-- > static_cast<std::size_t>(trailLim[target]);) {
+        int var = trail[i] >> 1;
+        polarity[var] = assigns[var];
+        assigns[var] = -1;
+        reason[var] = -1;
+        if (heapIndex[var] < 0) heapInsert(var);
+    }
+    trail.resize(trailLim[target]);
+    trailLim.resize(target);
+    qhead = trail.size();
+}
+
+SatCore::Lit SatCore::pickBranchLit() {
+    while (!heap.empty()) {
+        int var = heapPop();
+        if (assigns[var] < 0) return polarity[var] == 1 ? positive(var) : negative(var);
+    }
+    return -1;
+}
+
+SatCore::Result SatCore::solve(const CancellationToken* stop) {
+    if (!ok) return Result::Unsatisfiable;
+    if (propagate() >= 0) return Result::Unsatisfiable;
+
+    maxLearnts = std::max<double>(numOriginal / 3.0, 2000.0);
+    for (int restart = 0;; ++restart) {
+        Result result = search(RestartPolicy::luby(restart) * restartUnit, stop);
+        if (result != Result::Unknown) return result;
+        if (stop && stop->isCancelled()) return Result::Unknown;
+    }
+}
+
+SatCore::Result SatCore::search(std::uint64_t conflictBudget, const CancellationToken* stop) {
+    std::uint64_t conflictsHere = 0;
+    while (true) {
+        int conflict = propagate();
+        if (conflict >= 0) {
+            ++conflicts;
+            ++conflictsHere;
+            if (decisionLevel() == 0) return Result::Unsatisfiable;
+
+            int backtrackLevel;
+            analyze(conflict, backtrackLevel);
+            cancelUntil(backtrackLevel);
+            if (learnt.size() == 1) {
+                enqueue(learnt[0], -1);
+            } else {
+                int index = attachClause(learnt, true);
+                bumpClause(clauses[index]);
+                ++numLearnts;
+                enqueue(learnt[0], index);
+            }
+            varInc /= varDecay;
+            claInc /= clauseDecay;
+            continue;
+        }
+
+        if (conflictsHere >= conflictBudget || (stop && stop->isCancelled())) {
+            cancelUntil(0);
+            return Result::Unknown;
+        }
+        if (numLearnts >= maxLearnts) reduceLearnts();
+
+        Lit next = pickBranchLit();
+        if (next < 0) return Result::Satisfiable;
+        ++decisions;
+        trailLim.push_back(static_cast<int>(trail.size()));
+        enqueue(next, -1);
+    }
+}
+
+// Deletes the less active half of the learnt clauses that are longer than
+// two literals and not the reason of a current assignment
+void SatCore::reduceLearnts() {
+    std::vector<int> candidates;
+    for (int i = 0; i < static_cast<int>(clauses.size()); ++i) {
+        const Clause& clause = clauses[i];
+        if (!clause.learnt || clause.deleted || clause.lits.size() <= 2) continue;
+        int var = clause.lits[0] >> 1;
+        if (reason[var] == i && litValue(clause.lits[0]) == 1) continue;
+        candidates.push_back(i);
+    }
+    std::sort(candidates.begin(), candidates.end(), [this](int a, int b) {
+        return clauses[a].activity < clauses[b].activity;
+    });
+    for (std::size_t k = 0; k < candidates.size() / 2; ++k) {
+        Clause& clause = clauses[candidates[k]];
+        clause.deleted = true;
+        std::vector<Lit>().swap(clause.lits);
+        --numLearnts;
+    }
+    maxLearnts *= 1.1;
+}
+
+void SatCore::bumpVar(int var) {
+    if ((activity[var] += varInc) > 1e100) {
+        for (double& a : activity) a *= 1e-100;
+        varInc *= 1e-100;
+    }
+    if (heapIndex[var] >= 0) heapUp(heapIndex[var]);
+}
+
+void SatCore::bumpClause(Clause& clause) {
+    if ((clause.activity += static_cast<float>(claInc)) > 1e20f) {
+        for (Clause& c : clauses)
+            if (c.learnt) c.activity *= 1e-20f;
+        claInc *= 1e-20;
+    }
+}
+
+void SatCore::heapInsert(int var) {
+    heapIndex[var] = static_cast<int>(heap.size());
+    heap.push_back(var);
+    heapUp(heapIndex[var]);
+}
+
+int SatCore::heapPop() {
+    int top = heap.front();
+    heap.front() = heap.back();
+    heapIndex[heap.front()] = 0;
+    heap.pop_back();
+    heapIndex[top] = -1;
+    if (!heap.empty()) heapDown(0);
+    return top;
+}
+
+void SatCore::heapUp(int pos) {
+    int var = heap[pos];
+    while (pos > 0) {
+        int parent = (pos - 1) / 2;
+        if (activity[heap[parent]] >= activity[var]) break;
+        heap[pos] = heap[parent];
+        heapIndex[heap[pos]] = pos;
+        pos = parent;
+    }
+    heap[pos] = var;
+    heapIndex[var] = pos;
+}
+
+void SatCore::heapDown(int pos) {
+    int var = heap[pos];
+    int size = static_cast<int>(heap.size());
+    while (2 * pos + 1 < size) {
+        int child = 2 * pos + 1;
+        if (child + 1 < size && activity[heap[child + 1]] > activity[heap[child]]) ++child;
+        if (activity[heap[child]] <= activity[var]) break;
+        heap[pos] = heap[child];
+        heapIndex[heap[pos]] = pos;
+        pos = child;
+    }
+    heap[pos] = var;
+    heapIndex[var] = pos;
+}
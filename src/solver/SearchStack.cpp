@@ -0,0 +1,155 @@
+//src/solver/SearchStack.cpp
+#include "solver/SearchStack.hpp"
+#include "core/SudokuUtils.hpp"
+#include <taskflow/taskflow.hpp>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+SearchStack::SearchStack(const Sudoku& sudoku, const ValueOrderer& orderer)
+    : size(sudoku.getSize()), orderer(orderer) {
+    for (int cell = 0; cell < size * size; ++cell)
+        if (sudoku.getValue(cell / size, cell % size) == 0) cells.push_back(cell);
+    frames.resize(cells.size());
+
+    switch (orderer.getOrder()) {
+    case ValueOrder::Ascending:
+        return;
+    case ValueOrder::Frequency:
+        givenCount.assign(size + 1, 0);
+        for (int cell = 0; cell < size * size; ++cell)
+            ++givenCount[sudoku.getValue(cell / size, cell % size)];
+        break;
+    case ValueOrder::LeastConstraining:
+        peers = SudokuUtils::buildPeers(sudoku, numPeers);
+        break;
+    case ValueOrder::Random:
+        break;
+    }
+    orderedValues.resize(cells.size() * size);
+    cursor.resize(cells.size());
+}
+
+void SearchStack::orderFrame(const Sudoku& board, int depth) {
+    cursor[depth] = 0;
+    int* values = &orderedValues[static_cast<std::size_t>(depth) * size];
+    const int* cellPeers = peers.empty() ? nullptr : &peers[cells[depth] * numPeers];
+    orderer.sort(frames[depth], values, [&](int val) {
+        if (orderer.getOrder() == ValueOrder::Frequency) return -givenCount[val];
+        const Sudoku::Mask bit = Sudoku::Mask(1) << (val - 1);
+        int eliminated = 0;
+        for (int k = 0; k < numPeers; ++k) {
+            const int peer = cellPeers[k];
+            if (board.getValue(peer / size, peer % size) != 0) continue;
+            if (board.getCandidates(peer / size, peer % size) & bit) ++eliminated;
+        }
+        return eliminated;
+    });
+}
+
+SearchStack::Branch SearchStack::root(const Sudoku& sudoku) const {
+    Branch branch{sudoku, 0, 0};
+    if (!cells.empty()) branch.remaining = sudoku.getCandidates(cells[0] / size, cells[0] % size);
+    return branch;
+}
+
+bool SearchStack::split(const Sudoku& board, Branch& stolen) {
+    int depth = base;
+    while (depth <= top && frames[depth] == 0) ++depth;
+    if (depth > top) return false;
+
+    stolen.board = board;
+    for (int d = depth; d <= top; ++d)
+        stolen.board.setValue(cells[d] / size, cells[d] % size, 0);
+    stolen.depth = depth;
+    stolen.remaining = frames[depth];
+    frames[depth] = 0;
+    return true;
+}
+
+void parallelStackSearch(tf::Executor& executor, const Sudoku& sudoku,
+                         const std::function<bool(const Sudoku&)>& onLeaf,
+                         const std::function<bool()>& stop,
+                         const ValueOrderer& orderer) {
+    std::mutex mutex;
+    std::condition_variable workReady;
+    std::deque<SearchStack::Branch> queue;
+    int active = 0;                       // workers holding a branch
+    std::atomic<int> waiting{0};          // workers asking for one
+    std::atomic<int> queued{1};
+    std::atomic<bool> ended{false};
+
+    SearchStack prototype(sudoku, orderer);
+    queue.push_back(prototype.root(sudoku));
+
+    tf::Taskflow taskflow;
+    for (std::size_t w = 0; w < executor.num_workers(); ++w) {
+        taskflow.emplace([&]() {
+            SearchStack stack = prototype;
+            SearchStack::Branch branch;
+            while (true) {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    ++waiting;
+                    // Done once nobody holds a branch that could still be split
+                    workReady.wait(lock, [&] { return !queue.empty() || active == 0 || ended.load(); });
+                    --waiting;
+                    if (queue.empty() || ended.load()) return;
+                    branch = std::move(queue.front());
+                    queue.pop_front();
+                    --queued;
+                    ++active;
+                }
+
+                bool finished = stack.run(branch, onLeaf, [&]() {
+                    if (ended.load(std::memory_order_relaxed) || stop()) return true;
+                    if (queued.load(std::memory_order_relaxed) < waiting.load(std::memory_order_relaxed)) {
+                        SearchStack::Branch stolen;
+                        if (stack.split(branch.board, stolen)) {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            queue.push_back(std::move(stolen));
+                            ++queued;
+                            workReady.notify_one();
+                        }
+                    }
+                    return false;
+                });
+
+                std::lock_guard<std::mutex> lock(mutex);
+                --active;
+                if (finished || stop()) ended.store(true);
+                if (ended.load() || active == 0) workReady.notify_all();
+            }
+        });
+    }
+    executor.run(taskflow).wait();
+}
+
+bool parallelStackSolve(tf::Executor& executor, Sudoku& sudoku, const std::function<bool()>& stop,
+                        const ValueOrderer& orderer) {
+    std::atomic<bool> solved(false);
+    std::mutex mutex;
+
+    parallelStackSearch(executor, sudoku, [&](const Sudoku& board) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!solved.exchange(true)) sudoku = board;   // the first solution wins
+        return true;
+    }, stop, orderer);
+
+    return solved.load();
+}
+
+std::uint64_t parallelStackCount(tf::Executor& executor, const Sudoku& sudoku, std::uint64_t limit,
+                                 const std::function<bool()>& stop,
+                                 const ValueOrderer& orderer) {
+    if (limit == 0 || !SudokuUtils::hasConsistentGivens(sudoku)) return 0;
+
+    std::atomic<std::uint64_t> found(0);
+    parallelStackSearch(executor, sudoku, [&](const Sudoku&) {
+        return found.fetch_add(1) + 1 >= limit;
+    }, stop, orderer);
+
+    return std::min<std::uint64_t>(found.load(), limit);
+}
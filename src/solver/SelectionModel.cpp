@@ -0,0 +1,222 @@
+//src/solver/SelectionModel.cpp
+#include "solver/SelectionModel.hpp"
+#include "solver/AdaptiveSolver.hpp"
+#include "core/SudokuUtils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <tuple>
+
+namespace {
+
+constexpr double ridgeLambda = 0.1;   // keeps the fit sane on a handful of puzzles
+constexpr std::size_t minSamples = 3;
+
+using FeatureVector = std::array<double, PuzzleFeatures::kCount>;
+
+std::vector<std::string> splitCSV(const std::string& line) {
+    std::vector<std::string> fields;
+    std::stringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, ',')) fields.push_back(field);
+    return fields;
+}
+
+// Solves (X^T X + lambda I) w = X^T y by Gaussian elimination with partial
+// pivoting; the bias (column 0) is not regularized
+FeatureVector ridgeFit(const std::vector<FeatureVector>& xs, const std::vector<double>& ys) {
+    constexpr int n = PuzzleFeatures::kCount;
+    double a[n][n + 1] = {};
+    for (std::size_t s = 0; s < xs.size(); ++s)
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) a[i][j] += xs[s][i] * xs[s][j];
+            a[i][n] += xs[s][i] * ys[s];
+        }
+    for (int i = 1; i < n; ++i) a[i][i] += ridgeLambda;
+
+    for (int col = 0; col < n; ++col) {
+        int pivot = col;
+        for (int row = col + 1; row < n; ++row)
+            if (std::fabs(a[row][col]) > std::fabs(a[pivot][col])) pivot = row;
+        std::swap(a[col], a[pivot]);
+        if (std::fabs(a[col][col]) < 1e-12) continue;
+        for (int row = 0; row < n; ++row) {
+            if (row == col) continue;
+            double factor = a[row][col] / a[col][col];
+            for (int k = col; k <= n; ++k) a[row][k] -= factor * a[col][k];
+        }
+    }
+
+    FeatureVector w{};
+    for (int i = 0; i < n; ++i)
+        w[i] = std::fabs(a[i][i]) < 1e-12 ? 0.0 : a[i][n] / a[i][i];
+    return w;
+}
+
+}
+
+std::array<double, PuzzleFeatures::kCount> PuzzleFeatures::vector() const {
+    double cells = static_cast<double>(size) * size;
+    return {1.0,
+            std::log(static_cast<double>(size)),
+            givensDensity,
+            forcedCells / cells,
+            candidateHistogram[0] / cells,
+            candidateHistogram[1] / cells,
+            candidateHistogram[2] / cells,
+            candidateHistogram[3] / cells};
+}
+
+PuzzleFeatures PuzzleFeatures::extract(const Sudoku& sudoku, ConstraintPropagator& propagator,
+                                       Sudoku& reduced) {
+    PuzzleFeatures features;
+    features.size = sudoku.getSize();
+    int size = features.size;
+
+    int givens = 0;
+    for (int r = 0; r < size; ++r)
+        for (int c = 0; c < size; ++c)
+            if (sudoku.getValue(r, c) != 0) ++givens;
+    features.givensDensity = static_cast<double>(givens) / (size * size);
+
+    reduced = sudoku;
+    PropagationResult result = propagator.propagate(reduced);
+    features.consistent = result.consistent;
+    features.forcedCells = result.cellsFilled;
+    if (!result.consistent) return features;
+    features.solvedByPropagation = reduced.isComplete();
+
+    const std::vector<Sudoku::Mask>& candidates = propagator.getCandidates();
+    for (int cell = 0; cell < size * size; ++cell) {
+        if (reduced.getValue(cell / size, cell % size) != 0) continue;
+        int count = SudokuUtils::countBits(candidates[cell]);
+        int bucket = count <= 2 ? 0 : count <= 4 ? 1 : count <= 8 ? 2 : 3;
+        ++features.candidateHistogram[bucket];
+    }
+    return features;
+}
+
+double SelectionModel::Candidate::predictLogMs(const FeatureVector& x) const {
+    double sum = 0.0;
+    for (int i = 0; i < PuzzleFeatures::kCount; ++i) sum += weights[i] * x[i];
+    return sum;
+}
+
+const SelectionModel::Candidate* SelectionModel::select(const PuzzleFeatures& features,
+                                                        int maxThreads) const {
+    const FeatureVector x = features.vector();
+    const Candidate* best = nullptr;
+    double bestLogMs = std::numeric_limits<double>::infinity();
+    for (const Candidate& candidate : candidates) {
+        if (candidate.numThreads > maxThreads || candidate.maxSize < features.size) continue;
+        double logMs = candidate.predictLogMs(x);
+        if (logMs < bestLogMs) {
+            bestLogMs = logMs;
+            best = &candidate;
+        }
+    }
+    return best;
+}
+
+SelectionModel SelectionModel::fitFromCSV(const std::string& csvPath) {
+    SelectionModel model;
+    std::ifstream in(csvPath);
+    std::string line;
+    if (!std::getline(in, line)) return model;
+
+    std::vector<std::string> header = splitCSV(line);
+    auto column = [&](const std::string& name) {
+        auto it = std::find(header.begin(), header.end(), name);
+        return it == header.end() ? -1 : static_cast<int>(it - header.begin());
+    };
+    const int solverCol = column("Solver"), threadsCol = column("Threads");
+    const int puzzleCol = column("Puzzle"), timeCol = column("TimeMs"), successCol = column("Success");
+    const int orderCol = column("ValueOrder");
+    if (solverCol < 0 || puzzleCol < 0 || timeCol < 0 || successCol < 0) return model;
+
+    // (engine, threads, puzzle) -> (time, measured behind propagation)
+    struct Sample { double timeMs; bool propagated; };
+    std::map<std::tuple<std::string, int, std::string>, Sample> samples;
+    const std::string propagationPrefix = "Propagation+";
+    while (std::getline(in, line)) {
+        std::vector<std::string> fields = splitCSV(line);
+        if (static_cast<int>(fields.size()) < static_cast<int>(header.size())) continue;
+        if (fields[successCol] != "true") continue;
+        // The engines run in auto mode with their default value order
+        if (orderCol >= 0 && fields[orderCol] != valueOrderName(ValueOrder::Ascending)) continue;
+
+        std::string engine = fields[solverCol];
+        bool propagated = engine.compare(0, propagationPrefix.size(), propagationPrefix) == 0;
+        if (propagated) engine = engine.substr(propagationPrefix.size());
+        if (!AdaptiveSolver::isKnownEngine(engine)) continue;
+
+        int threads = threadsCol >= 0 ? std::stoi(fields[threadsCol]) : 1;
+        Sample sample{std::stod(fields[timeCol]), propagated};
+        auto [it, inserted] = samples.try_emplace({engine, threads, fields[puzzleCol]}, sample);
+        if (!inserted && propagated && !it->second.propagated) it->second = sample;
+    }
+
+    // Features once per puzzle; unreadable paths (batch rows) drop out here
+    std::map<std::string, std::pair<bool, PuzzleFeatures>> features;
+    ConstraintPropagator propagator;
+    struct Data { std::vector<FeatureVector> xs; std::vector<double> ys; int maxSize = 0; };
+    std::map<std::pair<std::string, int>, Data> data;
+    for (const auto& [key, sample] : samples) {
+        const auto& [engine, threads, puzzlePath] = key;
+        auto found = features.find(puzzlePath);
+        if (found == features.end()) {
+            Sudoku puzzle, reduced;
+            bool loaded = puzzle.loadFromFile(puzzlePath);
+            PuzzleFeatures f;
+            if (loaded) f = PuzzleFeatures::extract(puzzle, propagator, reduced);
+            found = features.emplace(puzzlePath, std::make_pair(loaded, f)).first;
+        }
+        if (!found->second.first) continue;
+
+        Data& d = data[{engine, threads}];
+        d.xs.push_back(found->second.second.vector());
+        d.ys.push_back(std::log(std::max(sample.timeMs, 1e-3)));
+        d.maxSize = std::max(d.maxSize, found->second.second.size);
+    }
+
+    for (const auto& [key, d] : data) {
+        if (d.xs.size() < minSamples) continue;
+        model.candidates.push_back({key.first, key.second, d.maxSize, ridgeFit(d.xs, d.ys)});
+    }
+    return model;
+}
+
+bool SelectionModel::save(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) return false;
+    out << "# engine threads maxSize weights(bias, ln size, givens, forced, cand2, cand3-4, cand5-8, cand9+)\n";
+    out.precision(9);
+    for (const Candidate& candidate : candidates) {
+        out << candidate.engine << " " << candidate.numThreads << " " << candidate.maxSize;
+        for (double w : candidate.weights) out << " " << w;
+        out << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+bool SelectionModel::load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::vector<Candidate> loaded;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream ss(line);
+        Candidate candidate;
+        ss >> candidate.engine >> candidate.numThreads >> candidate.maxSize;
+        for (double& w : candidate.weights) ss >> w;
+        if (!ss || !AdaptiveSolver::isKnownEngine(candidate.engine)) return false;
+        loaded.push_back(candidate);
+    }
+    if (loaded.empty()) return false;
+    candidates = std::move(loaded);
+    return true;
+}
@@ -0,0 +1,68 @@
+//src/solver/SolutionStream.cpp
+#include "solver/SolutionStream.hpp"
+
+SolutionStream::SolutionStream(std::size_t batchSize, std::size_t maxBatches)
+    : batchSize(batchSize > 0 ? batchSize : 1), maxBatches(maxBatches > 0 ? maxBatches : 1) {}
+
+SolutionStream::Writer::Writer(SolutionStream& stream) : stream(stream) {
+    buffer.reserve(stream.batchSize);
+}
+
+SolutionStream::Writer::~Writer() {
+    flush();
+}
+
+bool SolutionStream::Writer::push(const Sudoku& solution) {
+    if (stream.stopped.load(std::memory_order_relaxed)) return false;
+    buffer.push_back(solution);
+    return buffer.size() < stream.batchSize || flush();
+}
+
+bool SolutionStream::Writer::flush() {
+    if (buffer.empty()) return !stream.stopped.load();
+    bool accepted = stream.pushBatch(std::move(buffer));
+    buffer.clear();
+    buffer.reserve(stream.batchSize);
+    return accepted;
+}
+
+bool SolutionStream::pushBatch(std::vector<Sudoku>&& batch) {
+    std::unique_lock<std::mutex> lock(mutex);
+    notFull.wait(lock, [this] { return batches.size() < maxBatches || stopped.load(); });
+    if (stopped.load()) return false;
+    batches.push_back(std::move(batch));
+    notEmpty.notify_one();
+    return true;
+}
+
+void SolutionStream::close() {
+    std::lock_guard<std::mutex> lock(mutex);
+    closed = true;
+    notEmpty.notify_all();
+}
+
+std::uint64_t SolutionStream::consume(const SolutionCallback& onSolution) {
+    std::uint64_t delivered = 0;
+    while (true) {
+        std::vector<Sudoku> batch;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            notEmpty.wait(lock, [this] { return !batches.empty() || closed; });
+            if (batches.empty()) return delivered;
+            batch = std::move(batches.front());
+            batches.pop_front();
+            notFull.notify_one();
+        }
+
+        for (const Sudoku& solution : batch) {
+            ++delivered;
+            if (!onSolution(solution)) {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopped.store(true);
+                batches.clear();
+                notFull.notify_all();
+                return delivered;
+            }
+        }
+    }
+}
@@ -0,0 +1,81 @@
+//src/solver/SolverBase.cpp
+#include "solver/SolverBase.hpp"
+#include "solver/SolverSession.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+std::uint64_t SolverBase::countSolutions(const Sudoku& sudoku, std::uint64_t limit) {
+    if (limit == 0) return 0;
+    Sudoku board = sudoku;
+    if (limit == 1) return solve(board) ? 1 : 0;
+
+    std::uint64_t found = 0;
+    enumerate(board, [&](const Sudoku&) { return ++found < limit; });
+    // Nothing enumerated may just mean the engine has no enumeration; a
+    // solution from solve then proves it cannot count this board
+    if (found == 0 && solve(board)) return CountUnsupported;
+    return found;
+}
+
+void SolverBase::solveBatchChunk(Sudoku* const* boards, std::size_t count, std::uint8_t* solved) {
+    for (std::size_t i = 0; i < count; ++i) solved[i] = solve(*boards[i]);
+}
+
+BatchResult SolverBase::solveBatch(Sudoku* boards, std::size_t count, const BatchOptions& options) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    BatchResult result;
+    result.total = count;
+    result.success.assign(count, 0);
+
+    // Large boards only stay out of the worker pool if solve itself can
+    // keep the pool busy with them
+    const bool intraPuzzle = hasIntraPuzzleParallelism();
+    std::vector<std::size_t> small, large;
+    for (std::size_t i = 0; i < count; ++i)
+        (intraPuzzle && boards[i].getSize() >= options.intraPuzzleMinSize ? large : small).push_back(i);
+
+    // Small boards: one clone per worker pulling whole puzzles, up to
+    // batchGrain() of them at a time. A batch too small for a full chunk
+    // per worker is spread over all of them, in chunks no smaller than
+    // batchMinGrain().
+    if (!small.empty()) {
+        auto session = options.session ? options.session : SolverSession::shared(options.numThreads);
+        tf::Executor& executor = session->getExecutor();
+        const std::size_t perWorker = (small.size() + executor.num_workers() - 1) / executor.num_workers();
+        const std::size_t grain = std::max<std::size_t>(
+            1, std::min(batchGrain(), std::max(batchMinGrain(), perWorker)));
+        std::size_t workers = std::min<std::size_t>(executor.num_workers(), (small.size() + grain - 1) / grain);
+
+        std::vector<std::unique_ptr<SolverBase>> clones;
+        for (std::size_t w = 0; w < workers; ++w) clones.push_back(clone());
+
+        std::atomic<std::size_t> next{0};
+        tf::Taskflow taskflow;
+        for (std::size_t w = 0; w < workers; ++w) {
+            taskflow.emplace([&, w]() {
+                SolverBase& solver = *clones[w];
+                std::vector<Sudoku*> chunk(grain);
+                std::vector<std::uint8_t> solved(grain);
+                for (std::size_t begin; (begin = next.fetch_add(grain)) < small.size();) {
+                    const std::size_t n = std::min(grain, small.size() - begin);
+                    for (std::size_t k = 0; k < n; ++k) chunk[k] = &boards[small[begin + k]];
+                    solver.solveBatchChunk(chunk.data(), n, solved.data());
+                    for (std::size_t k = 0; k < n; ++k) result.success[small[begin + k]] = solved[k];
+                }
+            });
+        }
+        executor.run(taskflow).wait();
+    }
+
+    // Large boards: intra-puzzle parallelism, from the calling thread
+    for (std::size_t i : large)
+        result.success[i] = solve(boards[i]);
+
+    auto end = std::chrono::high_resolution_clock::now();
+    result.solved = std::count(result.success.begin(), result.success.end(), 1);
+    result.elapsedMs = std::chrono::duration<double, std::milli>(end - start).count();
+    result.puzzlesPerSecond = result.elapsedMs > 0.0 ? count * 1000.0 / result.elapsedMs : 0.0;
+    return result;
+}
@@ -0,0 +1,19 @@
+//src/solver/SolverSession.cpp
+#include "solver/SolverSession.hpp"
+#include <map>
+#include <mutex>
+#include <thread>
+
+SolverSession::SolverSession(int numThreads)
+    : numThreads(numThreads > 0 ? numThreads : static_cast<int>(std::thread::hardware_concurrency())),
+      executor(this->numThreads) {}
+
+std::shared_ptr<SolverSession> SolverSession::shared(int numThreads) {
+    static std::mutex sessionsMutex;
+    static std::map<int, std::shared_ptr<SolverSession>> sessions;
+
+    std::lock_guard<std::mutex> lock(sessionsMutex);
+    auto& session = sessions[numThreads];
+    if (!session) session = std::make_shared<SolverSession>(numThreads);
+    return session;
+}
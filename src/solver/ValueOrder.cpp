@@ -0,0 +1,34 @@
+//src/solver/ValueOrder.cpp
+#include "solver/ValueOrder.hpp"
+
+namespace {
+
+struct NamedOrder {
+    const char* name;
+    ValueOrder order;
+};
+
+const NamedOrder namedOrders[] = {
+    {"ascending", ValueOrder::Ascending},
+    {"lcv", ValueOrder::LeastConstraining},
+    {"frequency", ValueOrder::Frequency},
+    {"random", ValueOrder::Random},
+};
+
+}
+
+bool parseValueOrder(const std::string& name, ValueOrder& order) {
+    for (const NamedOrder& named : namedOrders) {
+        if (name == named.name) {
+            order = named.order;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* valueOrderName(ValueOrder order) {
+    for (const NamedOrder& named : namedOrders)
+        if (named.order == order) return named.name;
+    return "ascending";
+}
@@ -0,0 +1,94 @@
+// tests/test_adaptive.cpp
+#include <catch2/catch_all.hpp>
+#include "core/Sudoku.hpp"
+#include "solver/AdaptiveSolver.hpp"
+#include "solver/SelectionModel.hpp"
+#include <filesystem>
+#include <fstream>
+using namespace std;
+
+TEST_CASE("AdaptiveSolver solves valid puzzles", "[adaptive]") {
+    vector<string> files = {
+        "../Test_Cases/9x9_hard.txt",
+        "../Test_Cases/16x16_hard.txt",
+        "../Test_Cases/25x25_easy.txt",
+        "../Test_Cases/25x25_hard.txt"
+    };
+
+    AdaptiveSolver solver(4);
+    for (const auto& file : files) {
+        SECTION("Puzzle: " + file) {
+            Sudoku puzzle;
+            REQUIRE(puzzle.loadFromFile(file));
+            REQUIRE(solver.solve(puzzle));
+            REQUIRE(puzzle.isComplete());
+
+            // Propagation settles the puzzle or a known engine gets it
+            const AdaptiveSolver::Selection& selection = solver.getLastSelection();
+            if (selection.features.solvedByPropagation) {
+                REQUIRE(selection.engine.empty());
+            } else {
+                REQUIRE(AdaptiveSolver::isKnownEngine(selection.engine));
+                REQUIRE(selection.numThreads >= 1);
+                REQUIRE(selection.numThreads <= 4);
+            }
+        }
+    }
+}
+
+TEST_CASE("AdaptiveSolver falls back to the default engines without a model", "[adaptive]") {
+    AdaptiveSolver solver(4);
+    Sudoku puzzle;
+    REQUIRE(puzzle.loadFromFile("../Test_Cases/16x16_hard.txt"));
+    REQUIRE(solver.solve(puzzle));
+    REQUIRE(solver.getLastSelection().engine == "DLX");
+    REQUIRE(solver.getLastSelection().numThreads == 1);
+
+    PuzzleFeatures features;
+    features.size = 9;
+    REQUIRE(string(AdaptiveSolver::defaultEngine(features)) == "Bitboard");
+}
+
+TEST_CASE("AdaptiveSolver fails on invalid puzzles", "[adaptive][invalid]") {
+    AdaptiveSolver solver(1);
+    Sudoku puzzle;
+    REQUIRE(puzzle.loadFromFile("../Test_Cases/invalidBoxes.txt"));
+    REQUIRE_FALSE(solver.solve(puzzle));
+}
+
+TEST_CASE("SelectionModel is fitted from benchmark results", "[adaptive]") {
+    const filesystem::path dir = filesystem::temp_directory_path();
+    const string csvPath = (dir / "adaptive_test_results.csv").string();
+    const string modelPath = (dir / "adaptive_test_model.txt").string();
+    {
+        ofstream csv(csvPath);
+        csv << "Solver,Threads,Puzzle,TimeMs,Success\n";
+        for (const char* puzzle : {"9x9_easy", "9x9_hard", "16x16_hard", "25x25_hard"}) {
+            string path = string("../Test_Cases/") + puzzle + ".txt";
+            csv << "DLX,1," << path << ",0.5,true\n";
+            csv << "Backtracking,1," << path << ",40,true\n";
+            csv << "ParallelDLX,4," << path << ",0.2,true\n";
+            csv << "Unknown,1," << path << ",0.01,true\n";
+        }
+        csv << "DLX,1,batch x3000,100,true\n";
+    }
+
+    SelectionModel model = SelectionModel::fitFromCSV(csvPath);
+    REQUIRE(model.getCandidates().size() == 3);
+
+    Sudoku puzzle, reduced;
+    REQUIRE(puzzle.loadFromFile("../Test_Cases/16x16_hard.txt"));
+    ConstraintPropagator propagator;
+    PuzzleFeatures features = PuzzleFeatures::extract(puzzle, propagator, reduced);
+    REQUIRE(model.select(features, 4)->engine == "ParallelDLX");
+    REQUIRE(model.select(features, 2)->engine == "DLX");
+
+    REQUIRE(model.save(modelPath));
+    SelectionModel loaded;
+    REQUIRE(loaded.load(modelPath));
+    REQUIRE(loaded.getCandidates().size() == 3);
+    REQUIRE(loaded.select(features, 2)->engine == "DLX");
+
+    filesystem::remove(csvPath);
+    filesystem::remove(modelPath);
+}
@@ -1,8 +1,13 @@
 // tests/test_backtracking.cpp
 #include <catch2/catch_all.hpp>
+#include "test_fixtures.hpp"
 #include "solver/BacktrackingSolver.hpp"
 #include "solver/ParallelBacktrackingSolver.hpp"
+#include "solver/FixedSizeSolver.hpp"
+#include "solver/SolutionStream.hpp"
 #include "core/Sudoku.hpp"
+#include <set>
+#include <thread>
 
 TEST_CASE("BacktrackingSolver solves valid puzzles", "[backtracking]") {
     std::vector<std::string> files = {
@@ -82,3 +87,154 @@ TEST_CASE("ParallelBacktrackingSolver detects unsolvable puzzles", "[backtrackin
         }
     }
 }
+
+TEST_CASE("FixedSizeSolver solves valid puzzles", "[backtracking][fixed]") {
+    std::vector<std::string> files = {
+        "../Test_Cases/9x9_easy.txt",
+        "../Test_Cases/9x9_hard.txt",
+        "../Test_Cases/16x16_easy.txt",
+        "../Test_Cases/25x25_easy.txt"
+    };
+
+    for (const auto& file : files) {
+        SECTION("Solving " + file) {
+            Sudoku sudoku;
+            REQUIRE(sudoku.loadFromFile(file));
+
+            CAPTURE(file);
+            FixedSizeSolver solver(1);
+            REQUIRE(solver.solve(sudoku));
+            REQUIRE(sudoku.isComplete());
+
+            int size = sudoku.getSize();
+            for (int row = 0; row < size; ++row)
+                for (int col = 0; col < size; ++col)
+                    REQUIRE(sudoku.isValid(row, col, sudoku.getValue(row, col)));
+        }
+    }
+}
+
+TEST_CASE("FixedSizeSolver detects unsolvable puzzles", "[backtracking][fixed][invalid]") {
+    std::vector<std::string> files = {
+        "../Test_Cases/invalidRows.txt",
+        "../Test_Cases/invalidColumns.txt",
+        "../Test_Cases/invalidBoxes.txt"
+    };
+
+    for (const auto& file : files) {
+        SECTION("Solving " + file) {
+            Sudoku sudoku;
+            REQUIRE(sudoku.loadFromFile(file));
+
+            CAPTURE(file);
+            FixedSizeSolver solver(1);
+            REQUIRE_FALSE(solver.solve(sudoku));
+        }
+    }
+}
+
+TEST_CASE("BacktrackingSolver MRV mode solves hard puzzles", "[backtracking][mrv]") {
+    std::vector<std::string> files = {
+        "../Test_Cases/9x9_hard.txt",
+        "../Test_Cases/16x16_hard.txt",
+        "../Test_Cases/25x25_hard.txt"
+    };
+
+    for (const auto& file : files) {
+        SECTION("Solving " + file) {
+            Sudoku sudoku;
+            REQUIRE(sudoku.loadFromFile(file));
+
+            CAPTURE(file);
+            BacktrackingSolver solver(1, BacktrackingSolver::CellOrder::MinimumRemaining);
+            REQUIRE(solver.solve(sudoku));
+            REQUIRE(sudoku.isComplete());
+
+            int size = sudoku.getSize();
+            for (int row = 0; row < size; ++row)
+                for (int col = 0; col < size; ++col)
+                    REQUIRE(sudoku.isValid(row, col, sudoku.getValue(row, col)));
+        }
+    }
+}
+
+TEST_CASE("BacktrackingSolver MRV mode visits fewer nodes", "[backtracking][mrv]") {
+    Sudoku puzzle;
+    REQUIRE(puzzle.loadFromFile("../Test_Cases/9x9_hard.txt"));
+
+    Sudoku rowMajorBoard = puzzle;
+    BacktrackingSolver rowMajor(1);
+    REQUIRE(rowMajor.solve(rowMajorBoard));
+
+    Sudoku mrvBoard = puzzle;
+    BacktrackingSolver mrv(1, BacktrackingSolver::CellOrder::MinimumRemaining);
+    REQUIRE(mrv.solve(mrvBoard));
+
+    REQUIRE(mrv.getNodeCount() * 10 < rowMajor.getNodeCount());
+    REQUIRE(mrvBoard.getBoard() == rowMajorBoard.getBoard());
+}
+
+TEST_CASE("BacktrackingSolver MRV mode detects unsolvable puzzles", "[backtracking][mrv][invalid]") {
+    std::vector<std::string> files = {
+        "../Test_Cases/invalidRows.txt",
+        "../Test_Cases/invalidColumns.txt",
+        "../Test_Cases/invalidBoxes.txt"
+    };
+
+    for (const auto& file : files) {
+        SECTION("Solving " + file) {
+            Sudoku sudoku;
+            REQUIRE(sudoku.loadFromFile(file));
+
+            CAPTURE(file);
+            BacktrackingSolver solver(1, BacktrackingSolver::CellOrder::MinimumRemaining);
+            REQUIRE_FALSE(solver.solve(sudoku));
+        }
+    }
+}
+
+TEST_CASE("ParallelBacktrackingSolver streams every solution", "[backtracking][enumerate]") {
+    const Sudoku puzzle = sparse9x9();
+
+    BacktrackingSolver sequential(1, BacktrackingSolver::CellOrder::MinimumRemaining);
+    ParallelBacktrackingSolver parallel(4);
+    for (SolverBase* solver : {static_cast<SolverBase*>(&sequential), static_cast<SolverBase*>(&parallel)}) {
+        std::set<std::vector<std::vector<int>>> seen;
+        std::uint64_t delivered = solver->enumerate(puzzle, [&](const Sudoku& solution) {
+            REQUIRE(solution.isComplete());
+            seen.insert(solution.getBoard());
+            return true;
+        });
+        REQUIRE(delivered == 336);
+        REQUIRE(seen.size() == 336);
+
+        std::uint64_t calls = 0;
+        REQUIRE(solver->enumerate(puzzle, [&](const Sudoku&) { return ++calls < 5; }) == 5);
+        REQUIRE(calls == 5);
+    }
+}
+
+TEST_CASE("SolutionStream bounds the queue and releases producers on stop", "[backtracking][enumerate]") {
+    Sudoku board;
+    REQUIRE(board.loadFromFile("../Test_Cases/9x9_easy.txt"));
+
+    SolutionStream stream(4, 2);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 4; ++p) {
+        producers.emplace_back([&]() {
+            SolutionStream::Writer writer(stream);
+            for (int i = 0; i < 1000 && writer.push(board); ++i) {}
+        });
+    }
+    std::thread closer([&]() {
+        for (auto& producer : producers) producer.join();
+        stream.close();
+    });
+
+    std::uint64_t received = 0;
+    std::uint64_t delivered = stream.consume([&](const Sudoku&) { return ++received < 100; });
+    closer.join();
+
+    REQUIRE(delivered == 100);
+    REQUIRE(stream.stopFlag().load());
+}
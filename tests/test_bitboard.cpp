@@ -0,0 +1,106 @@
+// tests/test_bitboard.cpp
+#include <catch2/catch_all.hpp>
+#include "core/Sudoku.hpp"
+#include "solver/BitboardSolver.hpp"
+#include "solver/DLXSolver.hpp"
+#include "solver/LaneBatchSolver.hpp"
+#include "core/SudokuUtils.hpp"
+using namespace std;
+
+TEST_CASE("Bitboard kernels agree with DLX on 9x9 puzzles", "[bitboard]") {
+    vector<BitboardSolver::Kernel> kernels = {BitboardSolver::Kernel::Portable};
+    if (BitboardSolver::isKernelSupported(BitboardSolver::Kernel::Avx2))
+        kernels.push_back(BitboardSolver::Kernel::Avx2);
+
+    for (const string file : {"../Test_Cases/9x9_easy.txt", "../Test_Cases/9x9_medium.txt",
+                              "../Test_Cases/9x9_hard.txt"}) {
+        Sudoku puzzle, expected;
+        REQUIRE(puzzle.loadFromFile(file));
+        expected = puzzle;
+        REQUIRE(DLXSolver(1).solve(expected));
+
+        for (auto kernel : kernels) {
+            CAPTURE(file, BitboardSolver::kernelName(kernel));
+            BitboardSolver solver(1, kernel);
+            REQUIRE(solver.getKernel() == kernel);
+            Sudoku board = puzzle;
+            REQUIRE(solver.solve(board));
+            for (int r = 0; r < 9; ++r)
+                for (int c = 0; c < 9; ++c)
+                    REQUIRE(board.getValue(r, c) == expected.getValue(r, c));
+        }
+    }
+}
+
+TEST_CASE("Bitboard solver rejects clashes and hands other sizes to DLX", "[bitboard]") {
+    BitboardSolver solver(1);
+    for (const string file : {"../Test_Cases/invalidRows.txt", "../Test_Cases/invalidColumns.txt",
+                              "../Test_Cases/invalidBoxes.txt"}) {
+        Sudoku sudoku;
+        REQUIRE(sudoku.loadFromFile(file));
+        CAPTURE(file);
+        REQUIRE_FALSE(solver.solve(sudoku));
+    }
+
+    // An empty board has a solution, but not two equal digits in a column
+    Sudoku empty(9);
+    REQUIRE(solver.countSolutions(empty, 5) == 5);
+    empty.setValue(0, 0, 1);
+    empty.setValue(8, 0, 1);
+    REQUIRE(solver.countSolutions(empty, 1) == 0);
+
+    Sudoku large;
+    REQUIRE(large.loadFromFile("../Test_Cases/16x16_hard.txt"));
+    REQUIRE(solver.solve(large));
+    REQUIRE(large.isComplete());
+}
+
+TEST_CASE("Lane batch solver matches DLX on a mixed batch", "[bitboard][batch]") {
+    vector<Sudoku> puzzles;
+    for (const string file : {"../Test_Cases/9x9_easy.txt", "../Test_Cases/9x9_medium.txt",
+                              "../Test_Cases/9x9_hard.txt", "../Test_Cases/invalidRows.txt",
+                              "../Test_Cases/invalidBoxes.txt", "../Test_Cases/16x16_easy.txt"}) {
+        Sudoku puzzle;
+        REQUIRE(puzzle.loadFromFile(file));
+        puzzles.push_back(puzzle);
+    }
+    puzzles.push_back(Sudoku(9));
+
+    vector<bool> expected;
+    for (const Sudoku& puzzle : puzzles) {
+        Sudoku board = puzzle;
+        expected.push_back(DLXSolver(1).solve(board));
+    }
+
+    // More boards than one chunk of lanes, so lanes get refilled
+    vector<Sudoku> batch;
+    for (int copy = 0; copy < 50; ++copy) batch.insert(batch.end(), puzzles.begin(), puzzles.end());
+
+    for (auto kernel : {BitboardSolver::Kernel::Portable, BitboardSolver::Kernel::Auto}) {
+        LaneBatchSolver solver(2, kernel);
+        vector<Sudoku> boards = batch;
+        BatchOptions options;
+        options.numThreads = 2;
+        BatchResult result = solver.solveBatch(boards, options);
+
+        REQUIRE(result.total == boards.size());
+        for (size_t i = 0; i < boards.size(); ++i) {
+            const Sudoku& puzzle = puzzles[i % puzzles.size()];
+            CAPTURE(i, BitboardSolver::kernelName(solver.getKernel()));
+            REQUIRE(static_cast<bool>(result.success[i]) == expected[i % puzzles.size()]);
+            if (!result.success[i]) continue;
+            REQUIRE(boards[i].isComplete());
+            REQUIRE(SudokuUtils::hasConsistentGivens(boards[i]));
+            for (int r = 0; r < puzzle.getSize(); ++r)
+                for (int c = 0; c < puzzle.getSize(); ++c)
+                    if (puzzle.getValue(r, c) != 0) REQUIRE(boards[i].getValue(r, c) == puzzle.getValue(r, c));
+        }
+    }
+
+    // A single solve is a batch of one
+    LaneBatchSolver single(1);
+    Sudoku hard = puzzles[2];
+    REQUIRE(single.solve(hard));
+    REQUIRE(hard.isComplete());
+    REQUIRE(single.getLastStats().solvedInLanes == 1);
+}
@@ -1,9 +1,11 @@
 // tests/test_bruteforce.cpp
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch_all.hpp>
+#include "test_fixtures.hpp"
 #include "core/Sudoku.hpp"
 #include "solver/BruteForceSolver.hpp"
 #include "solver/ParallelBruteForceSolver.hpp"
+#include "solver/SearchStack.hpp"
 #include <filesystem>
 
 using namespace std;
@@ -57,3 +59,29 @@ TEST_CASE("ParallelBruteForceSolver solves small puzzles", "[bruteforce]") {
         }
     }
 }
+
+TEST_CASE("SearchStack splits off untried values without losing leaves", "[bruteforce][stack]") {
+    const Sudoku puzzle = sparse9x9();
+
+    SearchStack stack(puzzle);
+    SearchStack::Branch branch = stack.root(puzzle);
+    vector<SearchStack::Branch> stolen;
+    int leaves = 0;
+    stack.run(branch, [&](const Sudoku& board) {
+        REQUIRE(board.isComplete());
+        ++leaves;
+        return false;
+    }, [&]() {
+        SearchStack::Branch part;
+        if (stolen.size() < 8 && stack.split(branch.board, part)) stolen.push_back(part);
+        return false;
+    });
+    REQUIRE_FALSE(stolen.empty());
+    REQUIRE(branch.board.getEmptyCells().size() == puzzle.getEmptyCells().size());
+
+    for (auto& part : stolen) {
+        SearchStack thief(puzzle);
+        thief.run(part, [&](const Sudoku&) { ++leaves; return false; }, [] { return false; });
+    }
+    REQUIRE(leaves == 336);
+}
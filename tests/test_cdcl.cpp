@@ -0,0 +1,82 @@
+// tests/test_cdcl.cpp
+#include <catch2/catch_all.hpp>
+#include "core/Sudoku.hpp"
+#include "solver/CDCLSolver.hpp"
+#include "solver/SatCore.hpp"
+using namespace std;
+
+TEST_CASE("SatCore decides small formulas", "[cdcl]") {
+    using L = SatCore;
+
+    SECTION("Pigeonhole 4 into 3 is unsatisfiable") {
+        SatCore core;
+        int p[4][3];
+        for (auto& pigeon : p)
+            for (int& hole : pigeon) hole = core.newVar();
+        for (auto& pigeon : p) core.addClause({L::positive(pigeon[0]), L::positive(pigeon[1]), L::positive(pigeon[2])});
+        for (int h = 0; h < 3; ++h)
+            for (int a = 0; a < 4; ++a)
+                for (int b = a + 1; b < 4; ++b) core.addClause({L::negative(p[a][h]), L::negative(p[b][h])});
+        REQUIRE(core.solve() == SatCore::Result::Unsatisfiable);
+    }
+
+    SECTION("Satisfiable formula yields a model") {
+        SatCore core;
+        int a = core.newVar(), b = core.newVar(), c = core.newVar();
+        core.addClause({L::positive(a), L::positive(b)});
+        core.addClause({L::negative(a), L::positive(c)});
+        core.addClause({L::negative(b), L::negative(c)});
+        core.addClause({L::negative(c), L::positive(a)});
+        REQUIRE(core.solve() == SatCore::Result::Satisfiable);
+        bool va = core.getValue(a), vb = core.getValue(b), vc = core.getValue(c);
+        REQUIRE((va || vb));
+        REQUIRE((!va || vc));
+        REQUIRE((!vb || !vc));
+        REQUIRE((!vc || va));
+    }
+}
+
+TEST_CASE("CDCL Solver solves valid puzzles", "[cdcl]") {
+    vector<string> files = {
+        "../Test_Cases/9x9_hard.txt",
+        "../Test_Cases/16x16_hard.txt",
+        "../Test_Cases/25x25_easy.txt",
+        "../Test_Cases/25x25_hard.txt"
+    };
+
+    for (const auto& file : files) {
+        SECTION("Puzzle: " + file) {
+            Sudoku puzzle;
+            REQUIRE(puzzle.loadFromFile(file));
+            Sudoku original = puzzle;
+
+            CDCLSolver solver;
+            REQUIRE(solver.solve(puzzle));
+            REQUIRE(puzzle.isComplete());
+            int size = puzzle.getSize();
+            for (int row = 0; row < size; ++row)
+                for (int col = 0; col < size; ++col) {
+                    REQUIRE(puzzle.isValid(row, col, puzzle.getValue(row, col)));
+                    if (original.getValue(row, col) != 0)
+                        REQUIRE(puzzle.getValue(row, col) == original.getValue(row, col));
+                }
+        }
+    }
+}
+
+TEST_CASE("CDCL Solver fails on invalid puzzles", "[cdcl][invalid]") {
+    vector<string> invalidFiles = {
+        "../Test_Cases/invalidRows.txt",
+        "../Test_Cases/invalidColumns.txt",
+        "../Test_Cases/invalidBoxes.txt"
+    };
+
+    for (const auto& file : invalidFiles) {
+        SECTION("Invalid Puzzle: " + file) {
+            Sudoku puzzle;
+            REQUIRE(puzzle.loadFromFile(file));
+            CDCLSolver solver;
+            REQUIRE_FALSE(solver.solve(puzzle));
+        }
+    }
+}
@@ -0,0 +1,85 @@
+// tests/test_counting.cpp
+#include <catch2/catch_all.hpp>
+#include "test_fixtures.hpp"
+using namespace std;
+
+TEST_CASE("Every engine counts solutions up to a limit", "[counting]") {
+    const Sudoku puzzle = sparse9x9();
+
+    for (auto& [name, engine] : allEngines()) {
+        SECTION(name) {
+            REQUIRE(engine->countSolutions(puzzle, 1000) == 336);
+            REQUIRE(engine->countSolutions(puzzle, 10) == 10);
+            REQUIRE(engine->countSolutions(puzzle, 0) == 0);
+            REQUIRE_FALSE(engine->hasUniqueSolution(puzzle));
+        }
+    }
+}
+
+TEST_CASE("Every engine recognizes unique and invalid puzzles", "[counting]") {
+    Sudoku unique, invalid;
+    REQUIRE(unique.loadFromFile("../Test_Cases/9x9_hard.txt"));
+    REQUIRE(invalid.loadFromFile("../Test_Cases/invalidBoxes.txt"));
+
+    for (auto& [name, engine] : allEngines()) {
+        SECTION(name) {
+            REQUIRE(engine->hasUniqueSolution(unique));
+            REQUIRE(engine->countSolutions(invalid, 2) == 0);
+        }
+    }
+}
+
+TEST_CASE("Engines without an enumeration do not claim a count", "[counting]") {
+    // Solves, but has no way to enumerate or count
+    struct SolveOnly : SolverBase {
+        DLXSolver dlx{1};
+        bool solve(Sudoku& sudoku) override { return dlx.solve(sudoku); }
+        unique_ptr<SolverBase> clone() const override { return make_unique<SolveOnly>(); }
+    };
+
+    Sudoku unique, invalid;
+    REQUIRE(unique.loadFromFile("../Test_Cases/9x9_hard.txt"));
+    REQUIRE(invalid.loadFromFile("../Test_Cases/invalidBoxes.txt"));
+
+    SolveOnly solver;
+    REQUIRE(solver.countSolutions(unique, 1) == 1);
+    REQUIRE(solver.countSolutions(unique, 2) == SolverBase::CountUnsupported);
+    REQUIRE_FALSE(solver.hasUniqueSolution(unique));
+    REQUIRE(solver.countSolutions(invalid, 2) == 0);
+}
+
+TEST_CASE("Value orders change the search but not the solutions", "[counting][order]") {
+    const Sudoku multi = sparse9x9();
+    Sudoku hard, expected;
+    REQUIRE(hard.loadFromFile("../Test_Cases/9x9_hard.txt"));
+    expected = hard;
+    REQUIRE(DLXSolver(1).solve(expected));
+
+    // Every engine that takes the orders
+    for (auto& [name, engine] : allEngines()) {
+        for (ValueOrder order : {ValueOrder::LeastConstraining, ValueOrder::Frequency, ValueOrder::Random}) {
+            if (!engine->setValueOrder(order, 7)) continue;
+            SECTION(name + " " + valueOrderName(order)) {
+                REQUIRE(engine->countSolutions(multi, 1000) == 336);
+
+                Sudoku board = hard;
+                REQUIRE(engine->solve(board));
+                // The stack searches do not count nodes, and the pre-pass
+                // may finish the board without a search
+                auto* propagating = dynamic_cast<PropagatingSolver*>(engine.get());
+                if (name.find("Brute") == string::npos && name.find("Parallel") == string::npos &&
+                    !(propagating && propagating->solvedByPropagation()))
+                    REQUIRE(engine->getNodeCount() > 0);
+                for (int r = 0; r < 9; ++r)
+                    for (int c = 0; c < 9; ++c)
+                        REQUIRE(board.getValue(r, c) == expected.getValue(r, c));
+            }
+        }
+    }
+
+    ValueOrder parsed;
+    REQUIRE(parseValueOrder("lcv", parsed));
+    REQUIRE(parsed == ValueOrder::LeastConstraining);
+    REQUIRE_FALSE(parseValueOrder("largest", parsed));
+    REQUIRE_FALSE(ParallelDLXSolver(2).setValueOrder(ValueOrder::Random));
+}
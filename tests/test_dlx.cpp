@@ -1,9 +1,13 @@
 // tests/test_dlx.cpp
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch_all.hpp>
+#include "test_fixtures.hpp"
 #include "core/Sudoku.hpp"
 #include "solver/DLXSolver.hpp"
 #include "solver/ParallelDLXSolver.hpp"
+#include "solver/SolverSession.hpp"
+#include "solver/BacktrackingSolver.hpp"
+#include "core/SudokuUtils.hpp"
 #include <filesystem>
 using namespace std;
 
@@ -97,3 +101,288 @@ TEST_CASE("ParallelDLX Solver fails on invalid puzzles", "[dlx][invalid]") {
         }
     }
 }
+
+TEST_CASE("ParallelDLX Solver reuses a shared session across solves", "[dlx][session]") {
+    auto session = std::make_shared<SolverSession>(4);
+    ParallelDLXSolver first(4, session);
+    ParallelDLXSolver second(4, session);
+
+    for (int round = 0; round < 3; ++round) {
+        for (ParallelDLXSolver* solver : {&first, &second}) {
+            Sudoku puzzle;
+            REQUIRE(puzzle.loadFromFile("../Test_Cases/16x16_hard.txt"));
+            REQUIRE(solver->solve(puzzle));
+            REQUIRE(puzzle.isComplete());
+        }
+    }
+}
+
+TEST_CASE("ParallelDLX Solver solves a batch of mixed puzzles", "[dlx][batch]") {
+    vector<string> files = {
+        "../Test_Cases/9x9_easy.txt",
+        "../Test_Cases/9x9_hard.txt",
+        "../Test_Cases/16x16_medium.txt",
+        "../Test_Cases/25x25_easy.txt",
+        "../Test_Cases/invalidRows.txt"
+    };
+
+    vector<Sudoku> batch;
+    for (int copy = 0; copy < 4; ++copy) {
+        for (const auto& file : files) {
+            Sudoku puzzle;
+            REQUIRE(puzzle.loadFromFile(file));
+            batch.push_back(puzzle);
+        }
+    }
+
+    BatchOptions options;
+    options.numThreads = 4;
+    options.session = std::make_shared<SolverSession>(4);
+    ParallelDLXSolver solver(4);
+    BatchResult result = solver.solveBatch(batch, options);
+
+    REQUIRE(result.total == batch.size());
+    REQUIRE(result.solved == batch.size() - 4);
+    for (size_t i = 0; i < batch.size(); ++i) {
+        bool invalid = i % files.size() == files.size() - 1;
+        REQUIRE(static_cast<bool>(result.success[i]) == !invalid);
+        if (!invalid) REQUIRE(batch[i].isComplete());
+    }
+}
+
+TEST_CASE("Single-threaded engines spread large batch boards over the workers", "[dlx][batch]") {
+    vector<Sudoku> batch(4);
+    for (Sudoku& board : batch) REQUIRE(board.loadFromFile("../Test_Cases/25x25_easy.txt"));
+
+    BatchOptions options;
+    options.numThreads = 4;
+    options.session = std::make_shared<SolverSession>(4);
+    DLXSolver solver(1);
+    REQUIRE_FALSE(solver.hasIntraPuzzleParallelism());
+    REQUIRE(ParallelDLXSolver(4, options.session).hasIntraPuzzleParallelism());
+
+    BatchResult result = solver.solveBatch(batch, options);
+    REQUIRE(result.solved == batch.size());
+    for (const Sudoku& board : batch) REQUIRE(board.isComplete());
+}
+
+TEST_CASE("ParallelDLX Solver enumerates in sequential DLX order", "[dlx][enumerate]") {
+    Sudoku sparse9 = sparse9x9();
+    Sudoku sparse16;
+    REQUIRE(sparse16.loadFromFile("../Test_Cases/16x16_easy.txt"));
+    for (int row = 0; row < 4; ++row)
+        for (int col = 0; col < 16; ++col) sparse16.setValue(row, col, 0);
+
+    for (Sudoku* puzzle : {&sparse9, &sparse16}) {
+        // Up to 2000 solutions, in order
+        auto collect = [&](SolverBase& solver) {
+            vector<vector<vector<int>>> boards;
+            solver.enumerate(*puzzle, [&](const Sudoku& solution) {
+                boards.push_back(solution.getBoard());
+                return boards.size() < 2000;
+            });
+            return boards;
+        };
+
+        DLXSolver sequential;
+        ParallelDLXSolver parallel(4);
+        auto expected = collect(sequential);
+        REQUIRE_FALSE(expected.empty());
+        REQUIRE(collect(parallel) == expected);
+    }
+
+    DLXSolver sequential;
+    REQUIRE(sequential.countSolutions(sparse9, 1000) == 336);
+    vector<Sudoku> all;
+    ParallelDLXSolver parallel(4);
+    REQUIRE(parallel.solveAll(sparse9, all));
+    REQUIRE(all.size() == 336);
+}
+
+TEST_CASE("Restarts keep solving once a budget runs out", "[dlx][restart]") {
+    vector<uint64_t> luby;
+    for (int i = 0; i < 15; ++i) luby.push_back(RestartPolicy::luby(i));
+    REQUIRE(luby == vector<uint64_t>{1, 1, 2, 1, 1, 2, 4, 1, 1, 2, 1, 1, 2, 4, 8});
+
+    // A geometric budget that never grows would restart forever on a
+    // board without a solution
+    RestartPolicy flat;
+    flat.schedule = RestartPolicy::Schedule::Geometric;
+    flat.growth = 1.0;
+    REQUIRE_FALSE(flat.valid());
+    REQUIRE_FALSE(DLXSolver(1).setRestartPolicy(flat));
+    REQUIRE_FALSE(BacktrackingSolver(1).setRestartPolicy(flat));
+
+    // The puzzle has two solutions, and randomized attempts may find either
+    Sudoku puzzle;
+    REQUIRE(puzzle.loadFromFile("../Test_Cases/16x16_hard.txt"));
+
+    vector<pair<string, unique_ptr<SolverBase>>> engines;
+    engines.emplace_back("DLX", make_unique<DLXSolver>(1));
+    engines.emplace_back("BacktrackingMRV", make_unique<BacktrackingSolver>(
+        1, BacktrackingSolver::CellOrder::MinimumRemaining));
+    for (auto& [name, engine] : engines) {
+        for (auto schedule : {RestartPolicy::Schedule::Luby, RestartPolicy::Schedule::Geometric}) {
+            SECTION(name + (schedule == RestartPolicy::Schedule::Luby ? " luby" : " geometric")) {
+                RestartPolicy policy;
+                policy.schedule = schedule;
+                policy.baseNodes = 4;   // far below what the puzzle needs
+                REQUIRE(engine->setRestartPolicy(policy));
+
+                Sudoku board = puzzle;
+                REQUIRE(engine->solve(board));
+                REQUIRE(engine->getRestartCount() > 0);
+                REQUIRE(board.isComplete());
+                REQUIRE(SudokuUtils::hasConsistentGivens(board));
+                for (int r = 0; r < 16; ++r)
+                    for (int c = 0; c < 16; ++c)
+                        if (puzzle.getValue(r, c) != 0) REQUIRE(board.getValue(r, c) == puzzle.getValue(r, c));
+            }
+        }
+    }
+}
+
+TEST_CASE("Restarted row-major searches vary a deterministic value order", "[backtracking][restart]") {
+    Sudoku puzzle, expected;
+    REQUIRE(puzzle.loadFromFile("../Test_Cases/9x9_hard.txt"));
+    expected = puzzle;
+    REQUIRE(DLXSolver(1).solve(expected));
+
+    // With the ties left in ascending order every attempt would replay
+    // the same search, whatever the seed
+    for (ValueOrder order : {ValueOrder::LeastConstraining, ValueOrder::Frequency}) {
+        SECTION(valueOrderName(order)) {
+            vector<uint64_t> nodes;
+            for (unsigned seed : {1u, 2u}) {
+                BacktrackingSolver solver(1);
+                REQUIRE(solver.setValueOrder(order));
+                RestartPolicy policy;
+                policy.schedule = RestartPolicy::Schedule::Luby;
+                policy.baseNodes = 4;
+                policy.seed = seed;
+                REQUIRE(solver.setRestartPolicy(policy));
+
+                Sudoku board = puzzle;
+                REQUIRE(solver.solve(board));
+                REQUIRE(solver.getRestartCount() > 0);
+                REQUIRE(board.getBoard() == expected.getBoard());
+                nodes.push_back(solver.getNodeCount());
+            }
+            REQUIRE(nodes[0] != nodes[1]);
+        }
+    }
+}
+
+TEST_CASE("DLX Solver goes back to ascending rows after another order", "[dlx][order]") {
+    // Few enough candidates for a pruned matrix, which is rebuilt in place,
+    // and two solutions
+    Sudoku puzzle;
+    REQUIRE(puzzle.loadFromFile("../Test_Cases/16x16_hard.txt"));
+
+    auto solutions = [&](DLXSolver& solver) {
+        vector<vector<vector<int>>> boards;
+        solver.enumerate(puzzle, [&](const Sudoku& board) {
+            boards.push_back(board.getBoard());
+            return true;
+        });
+        return boards;
+    };
+
+    DLXSolver fresh(1), switched(1);
+    for (ValueOrder order : {ValueOrder::LeastConstraining, ValueOrder::Random}) {
+        REQUIRE(switched.setValueOrder(order, 7));
+        Sudoku board = puzzle;
+        REQUIRE(switched.solve(board));
+        solutions(switched);
+    }
+    REQUIRE(switched.setValueOrder(ValueOrder::Ascending));
+
+    Sudoku a = puzzle, b = puzzle;
+    REQUIRE(fresh.solve(a));
+    REQUIRE(switched.solve(b));
+    REQUIRE(switched.getNodeCount() == fresh.getNodeCount());
+    REQUIRE(solutions(switched) == solutions(fresh));
+}
+
+TEST_CASE("DLX Solver picks leftmost columns again after a restarted solve", "[dlx][restart]") {
+    Sudoku puzzle;
+    REQUIRE(puzzle.loadFromFile("../Test_Cases/16x16_hard.txt"));
+
+    auto solutions = [&](DLXSolver& solver) {
+        vector<vector<vector<int>>> boards;
+        solver.enumerate(puzzle, [&](const Sudoku& board) {
+            boards.push_back(board.getBoard());
+            return true;
+        });
+        return boards;
+    };
+
+    DLXSolver fresh(1), restarted(1);
+    RestartPolicy policy;
+    policy.schedule = RestartPolicy::Schedule::Luby;
+    policy.baseNodes = 4;
+    REQUIRE(restarted.setRestartPolicy(policy));
+    Sudoku board = puzzle;
+    REQUIRE(restarted.solve(board));
+    REQUIRE(restarted.getRestartCount() > 0);
+
+    REQUIRE(solutions(restarted) == solutions(fresh));
+    REQUIRE(restarted.countSolutions(puzzle, 10) == fresh.countSolutions(puzzle, 10));
+}
+
+TEST_CASE("DLX matrices only hold the rows the givens leave open", "[dlx][matrix]") {
+    Sudoku puzzle;
+    REQUIRE(puzzle.loadFromFile("../Test_Cases/25x25_hard.txt"));
+
+    // One row per candidate of an open cell, four nodes each
+    int candidates = 0;
+    for (int r = 0; r < 25; ++r)
+        for (int c = 0; c < 25; ++c) candidates += SudokuUtils::countBits(puzzle.getCandidates(r, c));
+    DancingLinks pruned;
+    REQUIRE(DLXSolver::buildExactCoverMatrix(pruned, puzzle));
+    REQUIRE(pruned.getNumNodes() == 4 * candidates);
+    REQUIRE(pruned.getMemoryBytes() * 4 < DLXSolver::exactCoverTemplate(25)->getMemoryBytes());
+
+    Sudoku clash = puzzle;
+    clash.setValue(0, 0, 0);
+    clash.setValue(0, 1, 0);
+    clash.setValue(0, 0, 7);
+    clash.setValue(0, 1, 7);
+    REQUIRE_FALSE(DLXSolver::buildExactCoverMatrix(pruned, clash));
+
+    // Propagating first narrows the matrix but keeps every solution
+    for (const string file : {"../Test_Cases/16x16_hard.txt", "../Test_Cases/25x25_hard.txt",
+                              "../Test_Cases/9x9_hard.txt"}) {
+        Sudoku board;
+        REQUIRE(board.loadFromFile(file));
+        CAPTURE(file);
+        DLXSolver plain, propagated;
+        propagated.setPropagation(true);
+        REQUIRE(propagated.countSolutions(board, 10) == plain.countSolutions(board, 10));
+
+        Sudoku solved = board;
+        REQUIRE(propagated.solve(solved));
+        REQUIRE(solved.isComplete());
+        REQUIRE(SudokuUtils::hasConsistentGivens(solved));
+    }
+}
+
+TEST_CASE("ParallelDLX worker scratch carries over between boards", "[dlx][scratch]") {
+    auto session = std::make_shared<SolverSession>(4);
+    ParallelDLXSolver solver(4, session);
+
+    // Prefixes and rows of one solve stay in the workers' arenas and
+    // buffers for the next, which may be of another size
+    for (int round = 0; round < 2; ++round) {
+        for (const string file : {"../Test_Cases/16x16_hard.txt", "../Test_Cases/9x9_hard.txt",
+                                  "../Test_Cases/25x25_easy.txt"}) {
+            Sudoku puzzle;
+            REQUIRE(puzzle.loadFromFile(file));
+            CAPTURE(file, round);
+            REQUIRE(solver.countSolutions(puzzle, 2) >= 1);
+            REQUIRE(solver.solve(puzzle));
+            REQUIRE(puzzle.isComplete());
+            REQUIRE(SudokuUtils::hasConsistentGivens(puzzle));
+        }
+    }
+}
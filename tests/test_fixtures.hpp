@@ -0,0 +1,57 @@
+// tests/test_fixtures.hpp
+#pragma once
+
+#include <catch2/catch_all.hpp>
+#include "core/Sudoku.hpp"
+#include "solver/SolverBase.hpp"
+#include "solver/BacktrackingSolver.hpp"
+#include "solver/ParallelBacktrackingSolver.hpp"
+#include "solver/BruteForceSolver.hpp"
+#include "solver/ParallelBruteForceSolver.hpp"
+#include "solver/DLXSolver.hpp"
+#include "solver/ParallelDLXSolver.hpp"
+#include "solver/FixedSizeSolver.hpp"
+#include "solver/BitboardSolver.hpp"
+#include "solver/PropagatingSolver.hpp"
+#include "solver/CDCLSolver.hpp"
+#include "solver/PortfolioSolver.hpp"
+#include "solver/AdaptiveSolver.hpp"
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// 9x9_easy with its first two rows cleared: 336 solutions
+inline Sudoku sparse9x9() {
+    Sudoku puzzle;
+    REQUIRE(puzzle.loadFromFile("../Test_Cases/9x9_easy.txt"));
+    for (int col = 0; col < 9; ++col) {
+        puzzle.setValue(0, col, 0);
+        puzzle.setValue(1, col, 0);
+    }
+    return puzzle;
+}
+
+// One of every engine, by name
+inline std::vector<std::pair<std::string, std::unique_ptr<SolverBase>>> allEngines() {
+    std::vector<std::pair<std::string, std::unique_ptr<SolverBase>>> engines;
+    engines.emplace_back("Backtracking", std::make_unique<BacktrackingSolver>(1));
+    engines.emplace_back("BacktrackingMRV", std::make_unique<BacktrackingSolver>(
+        1, BacktrackingSolver::CellOrder::MinimumRemaining));
+    engines.emplace_back("ParallelBacktracking", std::make_unique<ParallelBacktrackingSolver>(4));
+    engines.emplace_back("BruteForce", std::make_unique<BruteForceSolver>(1));
+    engines.emplace_back("ParallelBruteForce", std::make_unique<ParallelBruteForceSolver>(4));
+    engines.emplace_back("DLX", std::make_unique<DLXSolver>(1));
+    engines.emplace_back("ParallelDLX", std::make_unique<ParallelDLXSolver>(4));
+    engines.emplace_back("FixedSize", std::make_unique<FixedSizeSolver>(1));
+    engines.emplace_back("Bitboard", std::make_unique<BitboardSolver>(1));
+    engines.emplace_back("Propagation+DLX",
+                         std::make_unique<PropagatingSolver>(std::make_unique<DLXSolver>(1)));
+    engines.emplace_back("CDCL", std::make_unique<CDCLSolver>(1));
+    auto portfolio = std::make_unique<PortfolioSolver>(2);
+    portfolio->addEngine("DLX", std::make_unique<DLXSolver>(1));
+    portfolio->addEngine("CDCL", std::make_unique<CDCLSolver>(1));
+    engines.emplace_back("Portfolio", std::move(portfolio));
+    engines.emplace_back("Adaptive", std::make_unique<AdaptiveSolver>(1));
+    return engines;
+}
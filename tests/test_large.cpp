@@ -0,0 +1,109 @@
+// tests/test_large.cpp
+#include <catch2/catch_all.hpp>
+#include "core/Sudoku.hpp"
+#include "solver/DLXSolver.hpp"
+#include "solver/CDCLSolver.hpp"
+#include "solver/PropagatingSolver.hpp"
+#include <filesystem>
+#include <fstream>
+using namespace std;
+
+static void requireSolved(const Sudoku& puzzle, const Sudoku& solved) {
+    REQUIRE(solved.isComplete());
+    int size = solved.getSize();
+    for (int row = 0; row < size; ++row)
+        for (int col = 0; col < size; ++col) {
+            int val = solved.getValue(row, col);
+            REQUIRE(solved.isValid(row, col, val));
+            if (puzzle.getValue(row, col) != 0) REQUIRE(val == puzzle.getValue(row, col));
+        }
+}
+
+TEST_CASE("Symbols cover every value up to 64", "[large]") {
+    for (int val = 0; val <= Sudoku::MaxSize; ++val)
+        REQUIRE(Sudoku::symbolValue(Sudoku::valueSymbol(val)) == val);
+    REQUIRE(Sudoku::symbolValue('.') == 0);
+    REQUIRE(Sudoku::symbolValue('A') == 10);
+    REQUIRE(Sudoku::symbolValue('$') == 64);
+    REQUIRE(Sudoku::symbolValue('-') == -1);
+
+    Sudoku board(64);
+    REQUIRE(board.getFullMask() == ~Sudoku::Mask(0));
+    REQUIRE(board.getCandidates(0, 0) == ~Sudoku::Mask(0));
+}
+
+TEST_CASE("Boards load from numbers, symbols and compact rows", "[large]") {
+    const string path = (filesystem::temp_directory_path() / "large_format_test.txt").string();
+    auto load = [&](const string& text, Sudoku& board) {
+        ofstream(path) << text;
+        return board.loadFromFile(path);
+    };
+
+    Sudoku numbers, symbols, compact;
+    string numberText = "16\n10 0 16";
+    string symbolText = "16\nA . G";
+    string compactText = "16\nA.G";
+    for (int k = 3; k < 256; ++k) {
+        numberText += " 0";
+        symbolText += " .";
+        compactText += k % 16 == 0 ? "\n." : ".";
+    }
+    REQUIRE(load(numberText, numbers));
+    REQUIRE(load(symbolText, symbols));
+    REQUIRE(load(compactText, compact));
+    for (const Sudoku* board : {&numbers, &symbols, &compact}) {
+        REQUIRE(board->getValue(0, 0) == 10);
+        REQUIRE(board->getValue(0, 1) == 0);
+        REQUIRE(board->getValue(0, 2) == 16);
+    }
+
+    Sudoku rejected;
+    REQUIRE_FALSE(load("16\nH" + string(255, '.'), rejected));   // 17 > 16
+    REQUIRE_FALSE(load("50\n", rejected));                       // not a square
+    REQUIRE_FALSE(load("81\n", rejected));                       // wider than a Mask
+    REQUIRE_FALSE(load("4\n1 2 3 4", rejected));                 // too few cells
+
+    filesystem::remove(path);
+}
+
+TEST_CASE("The expert large board needs search", "[large]") {
+    // 708 of 1296 cells given, unique; propagation stalls long before the end
+    Sudoku puzzle;
+    REQUIRE(puzzle.loadFromFile("../Test_Cases/36x36_expert.txt"));
+
+    PropagatingSolver propagating(make_unique<DLXSolver>(1));
+    Sudoku board = puzzle;
+    REQUIRE(propagating.solve(board));
+    REQUIRE_FALSE(propagating.solvedByPropagation());
+    REQUIRE(propagating.getNodeCount() > 0);
+    requireSolved(puzzle, board);
+    REQUIRE(DLXSolver(1).hasUniqueSolution(puzzle));
+}
+
+TEST_CASE("Large boards are solved", "[large]") {
+    vector<string> files = {
+        "../Test_Cases/36x36_easy.txt",
+        "../Test_Cases/36x36_hard.txt",
+        "../Test_Cases/36x36_expert.txt",
+        "../Test_Cases/49x49_easy.txt",
+        "../Test_Cases/49x49_hard.txt",
+        "../Test_Cases/64x64_easy.txt",
+        "../Test_Cases/64x64_hard.txt"
+    };
+
+    DLXSolver dlx(1);
+    CDCLSolver cdcl(1);
+    PropagatingSolver propagating(make_unique<DLXSolver>(1));
+    for (const auto& file : files) {
+        SECTION("Puzzle: " + file) {
+            Sudoku puzzle;
+            REQUIRE(puzzle.loadFromFile(file));
+            for (SolverBase* solver : {static_cast<SolverBase*>(&dlx), static_cast<SolverBase*>(&cdcl),
+                                       static_cast<SolverBase*>(&propagating)}) {
+                Sudoku board = puzzle;
+                REQUIRE(solver->solve(board));
+                requireSolved(puzzle, board);
+            }
+        }
+    }
+}
@@ -0,0 +1,101 @@
+// tests/test_portfolio.cpp
+#include <catch2/catch_all.hpp>
+#include "core/Sudoku.hpp"
+#include "solver/PortfolioSolver.hpp"
+#include "solver/BacktrackingSolver.hpp"
+#include "solver/BruteForceSolver.hpp"
+#include "solver/DLXSolver.hpp"
+#include "solver/ParallelDLXSolver.hpp"
+#include "solver/CDCLSolver.hpp"
+#include "solver/FixedSizeSolver.hpp"
+#include <chrono>
+#include <iostream>
+#include <sstream>
+using namespace std;
+
+static unique_ptr<PortfolioSolver> makePortfolio() {
+    auto portfolio = make_unique<PortfolioSolver>(3);
+    portfolio->addEngine("DLX", make_unique<DLXSolver>(1));
+    portfolio->addEngine("BacktrackingMRV", make_unique<BacktrackingSolver>(
+        1, BacktrackingSolver::CellOrder::MinimumRemaining));
+    portfolio->addEngine("CDCL", make_unique<CDCLSolver>(1));
+    return portfolio;
+}
+
+TEST_CASE("PortfolioSolver solves valid puzzles", "[portfolio]") {
+    vector<string> files = {
+        "../Test_Cases/9x9_hard.txt",
+        "../Test_Cases/16x16_hard.txt",
+        "../Test_Cases/25x25_hard.txt"
+    };
+
+    auto portfolio = makePortfolio();
+    for (const auto& file : files) {
+        SECTION("Puzzle: " + file) {
+            Sudoku puzzle;
+            REQUIRE(puzzle.loadFromFile(file));
+            REQUIRE(portfolio->solve(puzzle));
+            REQUIRE(puzzle.isComplete());
+            REQUIRE_FALSE(portfolio->getLastWinner().empty());
+        }
+    }
+}
+
+TEST_CASE("PortfolioSolver fails on invalid puzzles", "[portfolio][invalid]") {
+    auto portfolio = makePortfolio();
+    Sudoku puzzle;
+    REQUIRE(puzzle.loadFromFile("../Test_Cases/invalidBoxes.txt"));
+    REQUIRE_FALSE(portfolio->solve(puzzle));
+}
+
+TEST_CASE("PortfolioSolver clones stay quiet", "[portfolio]") {
+    auto portfolio = makePortfolio();
+    ostringstream captured;
+    streambuf* saved = cout.rdbuf(captured.rdbuf());
+    auto copy = portfolio->clone();
+    cout.rdbuf(saved);
+    REQUIRE(captured.str().find("PortfolioSolver") == string::npos);
+
+    Sudoku puzzle;
+    REQUIRE(puzzle.loadFromFile("../Test_Cases/9x9_hard.txt"));
+    REQUIRE(copy->solve(puzzle));
+}
+
+TEST_CASE("PortfolioSolver cancels the engines that lose", "[portfolio]") {
+    // Brute force would take practically forever on this board
+    PortfolioSolver portfolio(2);
+    portfolio.addEngine("BruteForce", make_unique<BruteForceSolver>(1));
+    portfolio.addEngine("DLX", make_unique<DLXSolver>(1));
+
+    Sudoku puzzle;
+    REQUIRE(puzzle.loadFromFile("../Test_Cases/25x25_hard.txt"));
+    auto start = chrono::steady_clock::now();
+    REQUIRE(portfolio.solve(puzzle));
+    auto elapsed = chrono::steady_clock::now() - start;
+
+    REQUIRE(portfolio.getLastWinner() == "DLX");
+    REQUIRE(elapsed < chrono::seconds(5));
+}
+
+TEST_CASE("Every engine gives up once its token is cancelled", "[portfolio][cancel]") {
+    Sudoku puzzle;
+    REQUIRE(puzzle.loadFromFile("../Test_Cases/16x16_hard.txt"));
+
+    vector<unique_ptr<SolverBase>> engines;
+    engines.push_back(make_unique<BacktrackingSolver>(1));
+    engines.push_back(make_unique<BacktrackingSolver>(1, BacktrackingSolver::CellOrder::MinimumRemaining));
+    engines.push_back(make_unique<BruteForceSolver>(1));
+    engines.push_back(make_unique<DLXSolver>(1));
+    engines.push_back(make_unique<ParallelDLXSolver>(4));
+    engines.push_back(make_unique<CDCLSolver>(1));
+    engines.push_back(make_unique<FixedSizeSolver>(1));
+
+    auto token = make_shared<CancellationToken>();
+    token->cancel();
+    for (auto& engine : engines) {
+        engine->setCancellationToken(token);
+        Sudoku board = puzzle;
+        REQUIRE_FALSE(engine->solve(board));
+        REQUIRE(engine->countSolutions(puzzle, 2) < 2);
+    }
+}
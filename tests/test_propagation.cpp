@@ -0,0 +1,105 @@
+// tests/test_propagation.cpp
+#include <catch2/catch_all.hpp>
+#include "test_fixtures.hpp"
+#include "core/Sudoku.hpp"
+#include "solver/ConstraintPropagator.hpp"
+#include "solver/PropagatingSolver.hpp"
+#include "solver/BacktrackingSolver.hpp"
+#include "solver/DLXSolver.hpp"
+using namespace std;
+
+static void requireSolved(const Sudoku& puzzle) {
+    REQUIRE(puzzle.isComplete());
+    int size = puzzle.getSize();
+    for (int row = 0; row < size; ++row)
+        for (int col = 0; col < size; ++col)
+            REQUIRE(puzzle.isValid(row, col, puzzle.getValue(row, col)));
+}
+
+TEST_CASE("ConstraintPropagator fills forced cells", "[propagation]") {
+    vector<string> files = {
+        "../Test_Cases/9x9_easy.txt",
+        "../Test_Cases/16x16_easy.txt",
+        "../Test_Cases/25x25_easy.txt"
+    };
+
+    for (const auto& file : files) {
+        Sudoku puzzle;
+        REQUIRE(puzzle.loadFromFile(file));
+
+        SECTION("Propagating: " + file) {
+            int emptyBefore = static_cast<int>(puzzle.getEmptyCells().size());
+            ConstraintPropagator propagator;
+            PropagationResult result = propagator.propagate(puzzle);
+
+            REQUIRE(result.consistent);
+            REQUIRE(result.cellsFilled > 0);
+            REQUIRE(result.cellsFilled == static_cast<int>(propagator.getFilledCells().size()));
+            REQUIRE(static_cast<int>(puzzle.getEmptyCells().size()) == emptyBefore - result.cellsFilled);
+        }
+    }
+}
+
+TEST_CASE("ConstraintPropagator detects contradictions", "[propagation][invalid]") {
+    vector<string> invalidFiles = {
+        "../Test_Cases/invalidRows.txt",
+        "../Test_Cases/invalidColumns.txt",
+        "../Test_Cases/invalidBoxes.txt"
+    };
+
+    for (const auto& file : invalidFiles) {
+        Sudoku puzzle;
+        REQUIRE(puzzle.loadFromFile(file));
+
+        SECTION("Invalid Puzzle: " + file) {
+            ConstraintPropagator propagator;
+            REQUIRE_FALSE(propagator.propagate(puzzle).consistent);
+        }
+    }
+}
+
+TEST_CASE("PropagatingSolver solves in front of other solvers", "[propagation]") {
+    vector<string> files = {
+        "../Test_Cases/9x9_hard.txt",
+        "../Test_Cases/16x16_hard.txt",
+        "../Test_Cases/25x25_hard.txt"
+    };
+
+    for (const auto& file : files) {
+        Sudoku puzzle;
+        REQUIRE(puzzle.loadFromFile(file));
+
+        SECTION("DLX: " + file) {
+            PropagatingSolver solver(std::make_unique<DLXSolver>(1));
+            REQUIRE(solver.solve(puzzle));
+            requireSolved(puzzle);
+        }
+
+        SECTION("Backtracking with node propagation: " + file) {
+            auto backtracking = std::make_unique<BacktrackingSolver>(
+                1, BacktrackingSolver::CellOrder::MinimumRemaining);
+            backtracking->setNodePropagation(true);
+            PropagatingSolver solver(std::move(backtracking));
+            REQUIRE(solver.solve(puzzle));
+            requireSolved(puzzle);
+        }
+    }
+}
+
+TEST_CASE("Node propagation keeps every solution", "[propagation]") {
+    const Sudoku puzzle = sparse9x9();
+
+    Sudoku plainBoard = puzzle;
+    vector<Sudoku> plain;
+    BacktrackingSolver plainSolver(1, BacktrackingSolver::CellOrder::MinimumRemaining);
+    REQUIRE(plainSolver.solveAll(plainBoard, plain));
+
+    Sudoku propagatedBoard = puzzle;
+    vector<Sudoku> propagated;
+    BacktrackingSolver propagatingSolver(1, BacktrackingSolver::CellOrder::MinimumRemaining);
+    propagatingSolver.setNodePropagation(true);
+    REQUIRE(propagatingSolver.solveAll(propagatedBoard, propagated));
+
+    REQUIRE(plain.size() > 1);
+    REQUIRE(propagated.size() == plain.size());
+}